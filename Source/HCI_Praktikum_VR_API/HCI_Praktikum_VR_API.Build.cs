@@ -23,6 +23,7 @@ public class HCI_Praktikum_VR_API : ModuleRules
             "UMG",
             "AudioAnalysisTools",
             "RuntimeAudioImporter",
+            "SignalProcessing",
             "Json",
             "JsonUtilities",
             "SlateCore",
@@ -32,6 +33,9 @@ public class HCI_Praktikum_VR_API : ModuleRules
 
         PrivateDependencyModuleNames.AddRange(new string[] {
             // No need for HeadMountedDisplay here if it's public
+            // RenderCore/RHI for thread and GPU frame times
+            "RenderCore",
+            "RHI"
         });
 
         // Uncomment if you are using Slate UI
@@ -0,0 +1,194 @@
+// AnalysisQualityControllerComponent.cpp
+
+#include "AnalysisQualityControllerComponent.h"
+#include "MelOverbandAnalyzerComponent.h"
+#include "HarmonicPercussiveComponent.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAnalysisQuality, Log, All);
+
+static FAnalysisQualityTier MakeTier(const TCHAR* Name, int32 FFTSize, int32 Bands, int32 HopDivisor, bool bHarmonicPercussive)
+{
+    FAnalysisQualityTier Tier;
+    Tier.Name = Name;
+    Tier.FFTSize = FFTSize;
+    Tier.OverBandCount = Bands;
+    Tier.HopDivisor = HopDivisor;
+    Tier.bHarmonicPercussive = bHarmonicPercussive;
+    return Tier;
+}
+
+UAnalysisQualityControllerComponent::UAnalysisQualityControllerComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = true;
+    // After the owner's Blueprint tick has run the analysis for this frame.
+    PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+
+    Tiers.Add(MakeTier(TEXT("High"), 2048, 24, 1, true));
+    Tiers.Add(MakeTier(TEXT("Medium"), 1024, 16, 1, true));
+    Tiers.Add(MakeTier(TEXT("Low"), 1024, 12, 2, false));
+    Tiers.Add(MakeTier(TEXT("Minimal"), 512, 8, 3, false));
+}
+
+void UAnalysisQualityControllerComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    const FString Dir = FPaths::ProjectSavedDir() + TEXT("StudyResults/AnalysisQuality/");
+    IFileManager::Get().MakeDirectory(*Dir, true);
+    TierLogPath = Dir + FString::Printf(TEXT("AnalysisQuality_%s.csv"), *FDateTime::UtcNow().ToString(TEXT("%Y%m%d_%H%M%S")));
+}
+
+void UAnalysisQualityControllerComponent::SetTargets(UMelOverbandAnalyzerComponent* InAnalyzer, UHarmonicPercussiveComponent* InSeparator, int32 InitialTier)
+{
+    Analyzer = InAnalyzer;
+    Separator = InSeparator;
+    CurrentTier = INDEX_NONE;
+    SetTier(InitialTier, TEXT("Initial"));
+}
+
+void UAnalysisQualityControllerComponent::BeginExternalMeasure()
+{
+    ExternalStartCycles = FPlatformTime::Cycles64();
+}
+
+void UAnalysisQualityControllerComponent::EndExternalMeasure()
+{
+    if (ExternalStartCycles != 0)
+    {
+        ExternalMs += float(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - ExternalStartCycles));
+        ExternalStartCycles = 0;
+    }
+}
+
+void UAnalysisQualityControllerComponent::SetTier(int32 TierIndex, const FString& Reason)
+{
+    if (Tiers.Num() == 0)
+    {
+        return;
+    }
+
+    TierIndex = FMath::Clamp(TierIndex, 0, Tiers.Num() - 1);
+    if (TierIndex == CurrentTier)
+    {
+        return;
+    }
+
+    const int32 FromTier = CurrentTier;
+    ApplyTier(TierIndex);
+
+    OverBudgetSeconds = 0.f;
+    UnderBudgetSeconds = 0.f;
+
+    UE_LOG(LogAnalysisQuality, Log, TEXT("Analysis tier %d -> %d (%s): %s, cost %.3f ms"),
+        FromTier, TierIndex, *Tiers[TierIndex].Name.ToString(), *Reason, SmoothedCostMs);
+    if (bLogTierChanges)
+    {
+        AppendTierLog(FromTier, TierIndex, Reason);
+    }
+
+    OnQualityTierChanged.Broadcast(TierIndex, Tiers[TierIndex]);
+}
+
+void UAnalysisQualityControllerComponent::ApplyTier(int32 TierIndex)
+{
+    const FAnalysisQualityTier& Tier = Tiers[TierIndex];
+    CurrentTier = TierIndex;
+    FrameCounter = 0;
+
+    // Before SetAnalyzer there is no sample rate to lay out bands with; TickComponent applies it later
+    bAnalyzerTierPending = true;
+    ApplyPendingAnalyzerTier();
+    if (Separator)
+    {
+        Separator->bProcessingEnabled = Tier.bHarmonicPercussive;
+    }
+}
+
+void UAnalysisQualityControllerComponent::ApplyPendingAnalyzerTier()
+{
+    if (!bAnalyzerTierPending || !Analyzer || !Analyzer->IsInitialized() || !Tiers.IsValidIndex(CurrentTier))
+    {
+        return;
+    }
+    const FAnalysisQualityTier& Tier = Tiers[CurrentTier];
+    Analyzer->Reconfigure(Tier.FFTSize, Tier.OverBandCount);
+    bAnalyzerTierPending = false;
+}
+
+void UAnalysisQualityControllerComponent::AppendTierLog(int32 FromTier, int32 ToTier, const FString& Reason)
+{
+    if (TierLogPath.IsEmpty())
+    {
+        return;
+    }
+
+    FString Lines;
+    if (!IFileManager::Get().FileExists(*TierLogPath))
+    {
+        Lines = TEXT("UtcTime,WorldSeconds,FromTier,ToTier,TierName,FFTSize,OverBandCount,HopDivisor,HarmonicPercussive,SmoothedCostMs,BudgetMs,Reason\n");
+    }
+
+    const FAnalysisQualityTier& Tier = Tiers[ToTier];
+    const UWorld* World = GetWorld();
+    Lines += FString::Printf(TEXT("%s,%.3f,%d,%d,%s,%d,%d,%d,%d,%.4f,%.4f,%s\n"),
+        *FDateTime::UtcNow().ToIso8601(),
+        World ? World->GetTimeSeconds() : 0.f,
+        FromTier, ToTier, *Tier.Name.ToString(),
+        Tier.FFTSize, Tier.OverBandCount, Tier.HopDivisor, Tier.bHarmonicPercussive ? 1 : 0,
+        SmoothedCostMs, BudgetMs, *Reason);
+
+    FFileHelper::SaveStringToFile(Lines, *TierLogPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+}
+
+void UAnalysisQualityControllerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    if (!Analyzer || !Tiers.IsValidIndex(CurrentTier))
+    {
+        return;
+    }
+
+    ApplyPendingAnalyzerTier();
+    if (bAnalyzerTierPending)
+    {
+        // Nothing analyzed yet, so nothing to measure
+        return;
+    }
+
+    const FAnalysisQualityTier& Tier = Tiers[CurrentTier];
+
+    if (bAnalyzeThisFrame)
+    {
+        // Amortized over the frames the hop divisor skips.
+        float CostMs = Analyzer->GetLastProcessMs() + ExternalMs;
+        if (Separator)
+        {
+            CostMs += Separator->GetLastProcessMs();
+        }
+        CostMs /= FMath::Max(1, Tier.HopDivisor);
+        SmoothedCostMs = FMath::Lerp(CostMs, SmoothedCostMs, CostSmoothing);
+    }
+    ExternalMs = 0.f;
+
+    OverBudgetSeconds = SmoothedCostMs > BudgetMs ? OverBudgetSeconds + DeltaTime : 0.f;
+    UnderBudgetSeconds = SmoothedCostMs < BudgetMs * StepUpFraction ? UnderBudgetSeconds + DeltaTime : 0.f;
+
+    if (OverBudgetSeconds > StepDownHoldSeconds && CurrentTier + 1 < Tiers.Num())
+    {
+        SetTier(CurrentTier + 1, TEXT("OverBudget"));
+    }
+    else if (UnderBudgetSeconds > StepUpHoldSeconds && CurrentTier > 0)
+    {
+        SetTier(CurrentTier - 1, TEXT("UnderBudget"));
+    }
+
+    FrameCounter++;
+    bAnalyzeThisFrame = (FrameCounter % FMath::Max(1, Tiers[CurrentTier].HopDivisor)) == 0;
+}
@@ -0,0 +1,179 @@
+// AnalyzerBackendBenchmark.cpp
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "DSP/AlignedBuffer.h"
+#include "DSP/FFTAlgorithm.h"
+#include "MelOverbandProcessor.h"
+#include "BandpassFilterBank.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAnalyzerBenchmark, Log, All);
+
+/**
+ * Analyzer.BenchmarkBackends [Bands=16] [Seconds=20]
+ *
+ * Runs the FFT and the filter-bank backend over the same synthetic signal at the
+ * VR frame rate hop and reports CPU time per second of audio, plus the measured
+ * time from a tone onset until the band level reaches half its steady value.
+ */
+namespace AnalyzerBenchmark
+{
+    static constexpr float SampleRate = 48000.f;
+    static constexpr int32 FrameSize = 1024;
+    static constexpr int32 HopSize = 667; // 72 fps
+
+    struct FFftBackend
+    {
+        TUniquePtr<Audio::IFFTAlgorithm> FFT;
+        TArray<float> Window;
+        Audio::FAlignedFloatBuffer TimeDomain, Complex;
+        TArray<float> Magnitudes;
+        TArray<int32> Edges;
+
+        FFftBackend(int32 Bands)
+        {
+            Audio::FFFTSettings Settings;
+            Settings.Log2Size = FMath::FloorLog2(uint32(FrameSize));
+            Settings.bArrays128BitAligned = true;
+            Settings.bEnableHardwareAcceleration = true;
+            FFT = Audio::FFFTFactory::NewFFTAlgorithm(Settings);
+
+            Window.SetNumUninitialized(FrameSize);
+            for (int32 i = 0; i < FrameSize; ++i)
+            {
+                Window[i] = 0.5f - 0.5f * FMath::Cos(2.f * PI * i / FrameSize);
+            }
+            TimeDomain.SetNumUninitialized(FrameSize);
+            Complex.SetNumUninitialized(FFT ? FFT->NumOutputFloats() : 0);
+            Magnitudes.SetNumUninitialized(FrameSize / 2 + 1);
+            FMelOverbandProcessor::ComputeBandEdges(FrameSize / 2, SampleRate, Bands, Edges);
+        }
+
+        /** Band averages of the FrameSize samples ending at Signal + End. */
+        void Levels(const float* Signal, int32 End, float* Out)
+        {
+            for (int32 i = 0; i < FrameSize; ++i)
+            {
+                const int32 Index = End - FrameSize + i;
+                TimeDomain[i] = Index >= 0 ? Signal[Index] * Window[i] : 0.f;
+            }
+            FFT->ForwardRealToComplex(TimeDomain.GetData(), Complex.GetData());
+            for (int32 k = 0; k < Magnitudes.Num(); ++k)
+            {
+                Magnitudes[k] = FMath::Sqrt(FMath::Square(Complex[2 * k]) + FMath::Square(Complex[2 * k + 1]));
+            }
+            FMelOverbandProcessor::ComputeBandAverages(Magnitudes.GetData(), Edges, Out);
+        }
+    };
+
+    /** Time from Onset until Level(t) >= 0.5 * Level(Onset + 0.5 s), evaluated every Step samples. */
+    template <typename LevelFn>
+    static float MeasureLatencyMs(int32 Onset, int32 Step, LevelFn&& Level)
+    {
+        const float Steady = Level(Onset + int32(0.5f * SampleRate));
+        for (int32 t = Onset; t < Onset + int32(0.5f * SampleRate); t += Step)
+        {
+            if (Level(t) >= 0.5f * Steady)
+            {
+                return 1000.f * (t - Onset) / SampleRate;
+            }
+        }
+        return -1.f;
+    }
+
+    static void Run(const TArray<FString>& Args)
+    {
+        const int32 Bands = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 64) : 16;
+        const float Seconds = Args.Num() > 1 ? FMath::Max(1.f, FCString::Atof(*Args[1])) : 20.f;
+
+        // Noise plus a few tones
+        const int32 NumSamples = int32(Seconds * SampleRate);
+        TArray<float> Signal;
+        Signal.SetNumUninitialized(NumSamples);
+        FRandomStream Random(1234);
+        for (int32 n = 0; n < NumSamples; ++n)
+        {
+            const float t = n / SampleRate;
+            Signal[n] = 0.1f * Random.FRandRange(-1.f, 1.f)
+                + 0.3f * FMath::Sin(2.f * PI * 110.f * t)
+                + 0.2f * FMath::Sin(2.f * PI * 1250.f * t)
+                + 0.1f * FMath::Sin(2.f * PI * 6000.f * t);
+        }
+
+        FMelOverbandProcessor Processor;
+        TArray<float> Levels, Vis;
+        Levels.SetNumZeroed(Bands);
+        Vis.SetNumZeroed(Bands);
+
+        // FFT backend
+        FFftBackend Fft(Bands);
+        if (!Fft.FFT)
+        {
+            UE_LOG(LogAnalyzerBenchmark, Error, TEXT("No FFT implementation available."));
+            return;
+        }
+        Processor.Init(Bands, FMelOverbandParams());
+        uint64 Start = FPlatformTime::Cycles64();
+        for (int32 End = HopSize; End <= NumSamples; End += HopSize)
+        {
+            Fft.Levels(Signal.GetData(), End, Levels.GetData());
+            Processor.Process(Levels.GetData(), Vis.GetData());
+        }
+        const double FftMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start);
+
+        // Filter-bank backend
+        TArray<float> EdgesHz;
+        FMelOverbandProcessor::ComputeBandEdgesHz(SampleRate, Bands, EdgesHz);
+        FBandpassFilterBank Bank;
+        Bank.Init(SampleRate, EdgesHz);
+        Processor.Init(Bands, FMelOverbandParams());
+        Start = FPlatformTime::Cycles64();
+        for (int32 Begin = 0; Begin + HopSize <= NumSamples; Begin += HopSize)
+        {
+            Bank.Process(Signal.GetData() + Begin, HopSize);
+            Bank.GetLevels(Levels.GetData());
+            Processor.Process(Levels.GetData(), Vis.GetData());
+        }
+        const double BankMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start);
+
+        // Latency: silence, then a tone at the centre of the middle band.
+        const int32 Band = Bands / 2;
+        const float ToneHz = FMath::Sqrt(FMath::Max(EdgesHz[Band], 20.f) * EdgesHz[Band + 1]);
+        const int32 Onset = int32(0.25f * SampleRate);
+        TArray<float> Burst;
+        Burst.SetNumZeroed(Onset + int32(SampleRate));
+        for (int32 n = Onset; n < Burst.Num(); ++n)
+        {
+            Burst[n] = 0.5f * FMath::Sin(2.f * PI * ToneHz * (n - Onset) / SampleRate);
+        }
+
+        constexpr int32 Step = 16;
+        const float FftLatency = MeasureLatencyMs(Onset, Step, [&](int32 t)
+            {
+                Fft.Levels(Burst.GetData(), t, Levels.GetData());
+                return Levels[Band];
+            });
+
+        // The bank is causal and stateful: run it up to each query point.
+        const float BankLatency = MeasureLatencyMs(Onset, Step, [&](int32 t)
+            {
+                Bank.Reset();
+                Bank.Process(Burst.GetData(), t);
+                Bank.GetLevels(Levels.GetData());
+                return Levels[Band];
+            });
+
+        UE_LOG(LogAnalyzerBenchmark, Display, TEXT("%d bands, %.0f s audio, hop %d:"), Bands, Seconds, HopSize);
+        UE_LOG(LogAnalyzerBenchmark, Display, TEXT("  FFT %d:      %.3f ms CPU per s audio, onset-to-half-level %.1f ms (+ up to %.1f ms hop wait)"),
+            FrameSize, FftMs / Seconds, FftLatency, 1000.f * HopSize / SampleRate);
+        UE_LOG(LogAnalyzerBenchmark, Display, TEXT("  Filter bank: %.3f ms CPU per s audio, onset-to-half-level %.1f ms (readable after any block)"),
+            BankMs / Seconds, BankLatency);
+    }
+
+    static FAutoConsoleCommand BenchmarkCommand(
+        TEXT("Analyzer.BenchmarkBackends"),
+        TEXT("Compare CPU cost and onset latency of the FFT and filter-bank analyzer backends. Args: [Bands=16] [Seconds=20]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
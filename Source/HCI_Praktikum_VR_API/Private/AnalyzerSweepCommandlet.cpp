@@ -0,0 +1,384 @@
+// AnalyzerSweepCommandlet.cpp
+
+#include "AnalyzerSweepCommandlet.h"
+#include "MelOverbandProcessor.h"
+#include "OfflineSpectrogram.h"
+#include "DecodedPcmCache.h"
+#include "SongLibrarySubsystem.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAnalyzerSweep, Log, All);
+
+namespace AnalyzerSweep
+{
+    static constexpr int32 NumParams = 6;
+    static const TCHAR* const ParamNames[NumParams] = {
+        TEXT("DecayEnv"), TEXT("DecayPeak"), TEXT("LogScaleG"), TEXT("ThreshAlpha"), TEXT("AttackCoef"), TEXT("VisSmoothAlpha") };
+    static constexpr int32 HistogramBins = 256;
+
+    /** Band averages of one song, ready to be replayed through any configuration. */
+    struct FSong
+    {
+        FString Name;
+        int32 NumFrames = 0;
+        float FrameRate = 0.f;
+        TArray<float> RawAverages; // frame-major, NumFrames * Bands
+        TArray<int32> Onsets;
+    };
+
+    struct FResult
+    {
+        FMelOverbandParams Params;
+        double DynamicRange = 0.0;
+        double JitterEnergy = 0.0;
+        double OnsetResponse = 0.0;
+        double OnsetLatencyMs = 0.0;
+    };
+
+    static float& ParamRef(FMelOverbandParams& P, int32 Index)
+    {
+        switch (Index)
+        {
+        case 0: return P.DecayEnv;
+        case 1: return P.DecayPeak;
+        case 2: return P.LogScaleG;
+        case 3: return P.ThreshAlpha;
+        case 4: return P.AttackCoef;
+        default: return P.VisSmoothAlpha;
+        }
+    }
+
+    /** "Min:Max:Step" or "a,b,c"; Default if the switch is absent. */
+    static bool ParseGrid(const FString& Params, const TCHAR* Name, float Default, TArray<float>& Out)
+    {
+        Out.Reset();
+        FString Value;
+        if (!FParse::Value(*Params, *FString::Printf(TEXT("%s="), Name), Value, false))
+        {
+            Out.Add(Default);
+            return true;
+        }
+
+        TArray<FString> Parts;
+        if (Value.Contains(TEXT(":")))
+        {
+            Value.ParseIntoArray(Parts, TEXT(":"));
+            if (Parts.Num() != 3)
+            {
+                return false;
+            }
+            const float Min = FCString::Atof(*Parts[0]);
+            const float Max = FCString::Atof(*Parts[1]);
+            const float Step = FCString::Atof(*Parts[2]);
+            if (Step <= 0.f || Max < Min)
+            {
+                return false;
+            }
+            for (int32 i = 0; Min + i * Step <= Max + Step * 0.5f; ++i)
+            {
+                Out.Add(Min + i * Step);
+            }
+        }
+        else
+        {
+            Value.ParseIntoArray(Parts, TEXT(","));
+            for (const FString& Part : Parts)
+            {
+                Out.Add(FCString::Atof(*Part));
+            }
+        }
+        return Out.Num() > 0;
+    }
+
+    static void GatherSongs(const FString& Params, TArray<FString>& OutFiles)
+    {
+        FString SongList;
+        if (FParse::Value(*Params, TEXT("Songs="), SongList, false))
+        {
+            SongList.ParseIntoArray(OutFiles, TEXT(";"));
+            return;
+        }
+
+        FString Folder = TEXT("Content/Musik");
+        FParse::Value(*Params, TEXT("Folder="), Folder, false);
+        if (FPaths::IsRelative(Folder))
+        {
+            Folder = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / Folder);
+        }
+
+        for (const TCHAR* Ext : { TEXT("mp3"), TEXT("wav"), TEXT("ogg"), TEXT("flac") })
+        {
+            TArray<FString> Found;
+            IFileManager::Get().FindFiles(Found, *(Folder / FString(TEXT("*.")) + Ext), true, false);
+            for (const FString& File : Found)
+            {
+                OutFiles.Add(Folder / File);
+            }
+        }
+    }
+
+    static bool PrepareSong(const FString& FilePath, int32 FrameSize, float Fps, int32 Bands, FSong& Out)
+    {
+        const FString Hash = USongLibrarySubsystem::HashFileContents(FilePath);
+        if (Hash.IsEmpty())
+        {
+            return false;
+        }
+        if (!FDecodedPcmCache::Exists(Hash) && !FDecodedPcmCache::DecodeFileToCache(FilePath, Hash, EDecodedPcmFormat::Int16))
+        {
+            return false;
+        }
+
+        FMappedDecodedPcm Pcm;
+        if (!Pcm.Open(FDecodedPcmCache::GetCachePath(Hash), Hash))
+        {
+            return false;
+        }
+
+        const int32 HopSize = FMath::Max(1, FMath::RoundToInt(Pcm.GetHeader().SampleRate / Fps));
+        FOfflineSpectrogram Spectrogram;
+        if (!Spectrogram.LoadOrCompute(Hash, Pcm, FrameSize, HopSize))
+        {
+            return false;
+        }
+
+        TArray<int32> Edges;
+        FMelOverbandProcessor::ComputeBandEdges(FrameSize / 2, Spectrogram.SampleRate, Bands, Edges);
+
+        Out.Name = FPaths::GetCleanFilename(FilePath);
+        Out.NumFrames = Spectrogram.NumFrames;
+        Out.FrameRate = Spectrogram.GetFrameRate();
+        Out.RawAverages.SetNumUninitialized(int64(Out.NumFrames) * Bands);
+        for (int32 t = 0; t < Out.NumFrames; ++t)
+        {
+            FMelOverbandProcessor::ComputeBandAverages(Spectrogram.GetFrame(t), Edges, Out.RawAverages.GetData() + int64(t) * Bands);
+        }
+        Spectrogram.DetectOnsets(Out.Onsets);
+        return Out.NumFrames > 0;
+    }
+
+    /** Run one configuration over one song and add its metrics to InOutResult. */
+    static void Evaluate(const FSong& Song, int32 Bands, FResult& InOutResult)
+    {
+        FMelOverbandProcessor Processor;
+        Processor.Init(Bands, InOutResult.Params);
+
+        TArray<float> Vis, Prev1, Prev2, MeanSeries;
+        Vis.SetNumZeroed(Bands);
+        Prev1.SetNumZeroed(Bands);
+        Prev2.SetNumZeroed(Bands);
+        MeanSeries.SetNumUninitialized(Song.NumFrames);
+        TArray<uint32> Histogram;
+        Histogram.SetNumZeroed(Bands * HistogramBins);
+
+        double Jitter = 0.0;
+        for (int32 t = 0; t < Song.NumFrames; ++t)
+        {
+            Processor.Process(Song.RawAverages.GetData() + int64(t) * Bands, Vis.GetData());
+
+            float Mean = 0.f;
+            for (int32 b = 0; b < Bands; ++b)
+            {
+                const float V = Vis[b];
+                Mean += V;
+                ++Histogram[b * HistogramBins + FMath::Clamp(int32(V * HistogramBins), 0, HistogramBins - 1)];
+                if (t >= 2)
+                {
+                    const float D2 = V - 2.f * Prev1[b] + Prev2[b];
+                    Jitter += D2 * D2;
+                }
+                Prev2[b] = Prev1[b];
+                Prev1[b] = V;
+            }
+            MeanSeries[t] = Mean / Bands;
+        }
+
+        // Dynamic range used: P95 - P5 per band, averaged.
+        double Range = 0.0;
+        const uint32 Lo = uint32(0.05 * Song.NumFrames);
+        const uint32 Hi = uint32(0.95 * Song.NumFrames);
+        for (int32 b = 0; b < Bands; ++b)
+        {
+            uint32 Acc = 0;
+            int32 P5 = -1, P95 = HistogramBins - 1;
+            for (int32 i = 0; i < HistogramBins; ++i)
+            {
+                Acc += Histogram[b * HistogramBins + i];
+                if (P5 < 0 && Acc > Lo) { P5 = i; }
+                if (Acc > Hi) { P95 = i; break; }
+            }
+            Range += double(P95 - FMath::Max(P5, 0)) / HistogramBins;
+        }
+
+        // Onset response: rise of the mean output within 250 ms after each onset, and time to half of it.
+        const int32 Window = FMath::Max(1, FMath::RoundToInt(0.25f * Song.FrameRate));
+        double Rise = 0.0, LatencyFrames = 0.0;
+        int32 NumOnsets = 0, NumResponsive = 0;
+        for (const int32 Onset : Song.Onsets)
+        {
+            if (Onset < 1 || Onset + Window >= Song.NumFrames)
+            {
+                continue;
+            }
+            const float Base = MeanSeries[Onset - 1];
+            float Max = Base;
+            for (int32 j = 0; j <= Window; ++j)
+            {
+                Max = FMath::Max(Max, MeanSeries[Onset + j]);
+            }
+            const float OnsetRise = Max - Base;
+            Rise += OnsetRise;
+            ++NumOnsets;
+            if (OnsetRise > 0.01f)
+            {
+                int32 j = 0;
+                while (MeanSeries[Onset + j] < Base + 0.5f * OnsetRise)
+                {
+                    ++j;
+                }
+                LatencyFrames += j;
+                ++NumResponsive;
+            }
+        }
+
+        InOutResult.DynamicRange += Range / Bands;
+        InOutResult.JitterEnergy += Song.NumFrames > 2 ? Jitter / (double(Song.NumFrames - 2) * Bands) : 0.0;
+        InOutResult.OnsetResponse += NumOnsets > 0 ? Rise / NumOnsets : 0.0;
+        InOutResult.OnsetLatencyMs += NumResponsive > 0 ? 1000.0 * LatencyFrames / NumResponsive / Song.FrameRate : 0.0;
+    }
+}
+
+UAnalyzerSweepCommandlet::UAnalyzerSweepCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UAnalyzerSweepCommandlet::Main(const FString& Params)
+{
+    using namespace AnalyzerSweep;
+    const double StartTime = FPlatformTime::Seconds();
+
+    int32 Bands = 16, FrameSize = 1024;
+    float Fps = 72.f;
+    FParse::Value(*Params, TEXT("Bands="), Bands);
+    FParse::Value(*Params, TEXT("FFT="), FrameSize);
+    FParse::Value(*Params, TEXT("FPS="), Fps);
+    if (Bands <= 0 || !FMath::IsPowerOfTwo(FrameSize) || Fps <= 0.f)
+    {
+        UE_LOG(LogAnalyzerSweep, Error, TEXT("Invalid -Bands, -FFT (power of two) or -FPS."));
+        return 1;
+    }
+
+    // Parameter grids
+    FMelOverbandParams Defaults;
+    FString Normalization;
+    if (FParse::Value(*Params, TEXT("Normalization="), Normalization) && Normalization.Equals(TEXT("Quantile"), ESearchCase::IgnoreCase))
+    {
+        Defaults.Normalization = EOverbandNormalization::Quantile;
+        FParse::Value(*Params, TEXT("QuantileDecay="), Defaults.QuantileDecay);
+    }
+    TArray<float> Grids[NumParams];
+    int64 NumConfigs = 1;
+    for (int32 p = 0; p < NumParams; ++p)
+    {
+        FMelOverbandParams Tmp = Defaults;
+        if (!ParseGrid(Params, ParamNames[p], ParamRef(Tmp, p), Grids[p]))
+        {
+            UE_LOG(LogAnalyzerSweep, Error, TEXT("Could not parse grid for %s."), ParamNames[p]);
+            return 1;
+        }
+        NumConfigs *= Grids[p].Num();
+    }
+    if (NumConfigs > MAX_int32)
+    {
+        UE_LOG(LogAnalyzerSweep, Error, TEXT("Grid too large (%lld configurations)."), NumConfigs);
+        return 1;
+    }
+
+    // Songs: spectra are cached per content hash, so reruns skip straight to the sweep.
+    TArray<FString> Files;
+    GatherSongs(Params, Files);
+    TArray<FSong> Songs;
+    Songs.SetNum(Files.Num());
+    TArray<bool> Prepared;
+    Prepared.SetNumZeroed(Files.Num());
+    ParallelFor(Files.Num(), [&](int32 i)
+        {
+            Prepared[i] = PrepareSong(Files[i], FrameSize, Fps, Bands, Songs[i]);
+        });
+    for (int32 i = Songs.Num() - 1; i >= 0; --i)
+    {
+        if (!Prepared[i])
+        {
+            UE_LOG(LogAnalyzerSweep, Warning, TEXT("Skipping %s"), *Files[i]);
+            Songs.RemoveAt(i);
+        }
+    }
+    if (Songs.Num() == 0)
+    {
+        UE_LOG(LogAnalyzerSweep, Error, TEXT("No usable songs."));
+        return 1;
+    }
+
+    const double PrepTime = FPlatformTime::Seconds();
+    UE_LOG(LogAnalyzerSweep, Display, TEXT("Prepared %d songs in %.1f s, sweeping %lld configurations."),
+        Songs.Num(), PrepTime - StartTime, NumConfigs);
+
+    // Sweep
+    TArray<FResult> Results;
+    Results.SetNum(int32(NumConfigs));
+    ParallelFor(int32(NumConfigs), [&](int32 ConfigIndex)
+        {
+            FResult& Result = Results[ConfigIndex];
+            Result.Params = Defaults;
+            int32 Rest = ConfigIndex;
+            for (int32 p = 0; p < NumParams; ++p)
+            {
+                ParamRef(Result.Params, p) = Grids[p][Rest % Grids[p].Num()];
+                Rest /= Grids[p].Num();
+            }
+
+            for (const FSong& Song : Songs)
+            {
+                Evaluate(Song, Bands, Result);
+            }
+
+            const double InvSongs = 1.0 / Songs.Num();
+            Result.DynamicRange *= InvSongs;
+            Result.JitterEnergy *= InvSongs;
+            Result.OnsetResponse *= InvSongs;
+            Result.OnsetLatencyMs *= InvSongs;
+        });
+
+    // Results
+    FString Csv = TEXT("DecayEnv,DecayPeak,LogScaleG,ThreshAlpha,AttackCoef,VisSmoothAlpha,DynamicRange,JitterEnergy,OnsetResponse,OnsetLatencyMs\n");
+    Csv.Reserve(Csv.Len() + Results.Num() * 96);
+    for (const FResult& R : Results)
+    {
+        Csv += FString::Printf(TEXT("%g,%g,%g,%g,%g,%g,%.4f,%.6g,%.4f,%.1f\n"),
+            R.Params.DecayEnv, R.Params.DecayPeak, R.Params.LogScaleG, R.Params.ThreshAlpha, R.Params.AttackCoef, R.Params.VisSmoothAlpha,
+            R.DynamicRange, R.JitterEnergy, R.OnsetResponse, R.OnsetLatencyMs);
+    }
+
+    FString OutPath = FPaths::ProjectSavedDir() / TEXT("AnalyzerSweep")
+        / FString::Printf(TEXT("Sweep_%s.csv"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+    FParse::Value(*Params, TEXT("Out="), OutPath, false);
+
+    if (!FFileHelper::SaveStringToFile(Csv, *OutPath))
+    {
+        UE_LOG(LogAnalyzerSweep, Error, TEXT("Could not write %s"), *OutPath);
+        return 1;
+    }
+
+    UE_LOG(LogAnalyzerSweep, Display, TEXT("Swept %lld configurations in %.1f s. Results: %s"),
+        NumConfigs, FPlatformTime::Seconds() - PrepTime, *FPaths::ConvertRelativePathToFull(OutPath));
+    return 0;
+}
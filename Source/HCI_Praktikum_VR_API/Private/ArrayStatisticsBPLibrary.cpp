@@ -0,0 +1,213 @@
+// ArrayStatisticsBPLibrary.cpp
+
+#include "ArrayStatisticsBPLibrary.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+    /** Partial Welford state; merged with Chan's parallel formula. */
+    struct FPartialStats
+    {
+        float Count = 0.f;
+        float Mean = 0.f;
+        float M2 = 0.f;
+        float Min = TNumericLimits<float>::Max();
+        float Max = TNumericLimits<float>::Lowest();
+        int32 MinIndex = INDEX_NONE;
+        int32 MaxIndex = INDEX_NONE;
+
+        void Merge(const FPartialStats& Other)
+        {
+            if (Other.Count == 0.f)
+            {
+                return;
+            }
+            const float Total = Count + Other.Count;
+            const float Delta = Other.Mean - Mean;
+            Mean += Delta * (Other.Count / Total);
+            M2 += Other.M2 + Delta * Delta * (Count * Other.Count / Total);
+            Count = Total;
+
+            // Ties go to the lower index so results match a sequential scan.
+            if (Other.Min < Min || (Other.Min == Min && Other.MinIndex < MinIndex))
+            {
+                Min = Other.Min;
+                MinIndex = Other.MinIndex;
+            }
+            if (Other.Max > Max || (Other.Max == Max && Other.MaxIndex < MaxIndex))
+            {
+                Max = Other.Max;
+                MaxIndex = Other.MaxIndex;
+            }
+        }
+    };
+}
+
+void UArrayStatisticsBPLibrary::ComputeStatistics(const float* Values, int32 Num, FArrayStatistics& OutStatistics)
+{
+    OutStatistics = FArrayStatistics();
+    OutStatistics.Num = Num;
+    if (Num <= 0)
+    {
+        return;
+    }
+
+    FPartialStats Total;
+    int32 i = 0;
+
+    if (Num >= 8)
+    {
+        // Four independent Welford accumulators; all lanes see the same count.
+        VectorRegister4Float Mean = VectorZeroFloat();
+        VectorRegister4Float M2 = VectorZeroFloat();
+        VectorRegister4Float Min = VectorLoad(Values);
+        VectorRegister4Float Max = Min;
+        VectorRegister4Float Index = MakeVectorRegisterFloat(0.f, 1.f, 2.f, 3.f);
+        VectorRegister4Float MinIndex = Index;
+        VectorRegister4Float MaxIndex = Index;
+        const VectorRegister4Float Four = VectorSetFloat1(4.f);
+
+        float Count = 0.f;
+        for (; i + 4 <= Num; i += 4)
+        {
+            const VectorRegister4Float X = VectorLoad(Values + i);
+            Count += 1.f;
+            const VectorRegister4Float Delta = VectorSubtract(X, Mean);
+            Mean = VectorMultiplyAdd(Delta, VectorSetFloat1(1.f / Count), Mean);
+            M2 = VectorMultiplyAdd(Delta, VectorSubtract(X, Mean), M2);
+
+            const VectorRegister4Float IsLess = VectorCompareLT(X, Min);
+            const VectorRegister4Float IsGreater = VectorCompareGT(X, Max);
+            Min = VectorSelect(IsLess, X, Min);
+            MinIndex = VectorSelect(IsLess, Index, MinIndex);
+            Max = VectorSelect(IsGreater, X, Max);
+            MaxIndex = VectorSelect(IsGreater, Index, MaxIndex);
+            Index = VectorAdd(Index, Four);
+        }
+
+        alignas(16) float LaneMean[4], LaneM2[4], LaneMin[4], LaneMax[4], LaneMinIndex[4], LaneMaxIndex[4];
+        VectorStoreAligned(Mean, LaneMean);
+        VectorStoreAligned(M2, LaneM2);
+        VectorStoreAligned(Min, LaneMin);
+        VectorStoreAligned(Max, LaneMax);
+        VectorStoreAligned(MinIndex, LaneMinIndex);
+        VectorStoreAligned(MaxIndex, LaneMaxIndex);
+
+        for (int32 Lane = 0; Lane < 4; ++Lane)
+        {
+            FPartialStats Partial;
+            Partial.Count = Count;
+            Partial.Mean = LaneMean[Lane];
+            Partial.M2 = LaneM2[Lane];
+            Partial.Min = LaneMin[Lane];
+            Partial.Max = LaneMax[Lane];
+            Partial.MinIndex = int32(LaneMinIndex[Lane]);
+            Partial.MaxIndex = int32(LaneMaxIndex[Lane]);
+            Total.Merge(Partial);
+        }
+    }
+
+    for (; i < Num; ++i)
+    {
+        FPartialStats Single;
+        Single.Count = 1.f;
+        Single.Mean = Single.Min = Single.Max = Values[i];
+        Single.MinIndex = Single.MaxIndex = i;
+        Total.Merge(Single);
+    }
+
+    OutStatistics.Mean = Total.Mean;
+    OutStatistics.Variance = FMath::Max(0.f, Total.M2 / Total.Count);
+    OutStatistics.StdDev = FMath::Sqrt(OutStatistics.Variance);
+    OutStatistics.Min = Total.Min;
+    OutStatistics.Max = Total.Max;
+    OutStatistics.MinIndex = Total.MinIndex;
+    OutStatistics.MaxIndex = Total.MaxIndex;
+}
+
+void UArrayStatisticsBPLibrary::Normalize(const float* Values, int32 Num, const FArrayStatistics& Statistics, EArrayNormalization Mode, float* OutValues)
+{
+    // Every mode is (x - Offset) * Scale; degenerate ranges map to 0.
+    float Offset = 0.f;
+    float Scale = 0.f;
+    switch (Mode)
+    {
+    case EArrayNormalization::ZScore:
+        Offset = Statistics.Mean;
+        Scale = Statistics.StdDev > KINDA_SMALL_NUMBER ? 1.f / Statistics.StdDev : 0.f;
+        break;
+    case EArrayNormalization::MinMax:
+        Offset = Statistics.Min;
+        Scale = (Statistics.Max - Statistics.Min) > KINDA_SMALL_NUMBER ? 1.f / (Statistics.Max - Statistics.Min) : 0.f;
+        break;
+    case EArrayNormalization::Max:
+        Scale = FMath::Abs(Statistics.Max) > KINDA_SMALL_NUMBER ? 1.f / Statistics.Max : 0.f;
+        break;
+    }
+
+    const VectorRegister4Float OffsetV = VectorSetFloat1(Offset);
+    const VectorRegister4Float ScaleV = VectorSetFloat1(Scale);
+    int32 i = 0;
+    for (; i + 4 <= Num; i += 4)
+    {
+        VectorStore(VectorMultiply(VectorSubtract(VectorLoad(Values + i), OffsetV), ScaleV), OutValues + i);
+    }
+    for (; i < Num; ++i)
+    {
+        OutValues[i] = (Values[i] - Offset) * Scale;
+    }
+}
+
+void UArrayStatisticsBPLibrary::ArrayMeanVariance(const TArray<float>& Values, float& OutMean, float& OutVariance, float& OutStdDev)
+{
+    FArrayStatistics Stats;
+    ComputeStatistics(Values.GetData(), Values.Num(), Stats);
+    OutMean = Stats.Mean;
+    OutVariance = Stats.Variance;
+    OutStdDev = Stats.StdDev;
+}
+
+void UArrayStatisticsBPLibrary::ArrayMinMax(const TArray<float>& Values, float& OutMin, int32& OutMinIndex, float& OutMax, int32& OutMaxIndex)
+{
+    FArrayStatistics Stats;
+    ComputeStatistics(Values.GetData(), Values.Num(), Stats);
+    OutMin = Stats.Min;
+    OutMinIndex = Stats.MinIndex;
+    OutMax = Stats.Max;
+    OutMaxIndex = Stats.MaxIndex;
+}
+
+FArrayStatistics UArrayStatisticsBPLibrary::ArrayStatistics(const TArray<float>& Values)
+{
+    FArrayStatistics Stats;
+    ComputeStatistics(Values.GetData(), Values.Num(), Stats);
+    return Stats;
+}
+
+void UArrayStatisticsBPLibrary::ZScoreInPlace(TArray<float>& Values, float& OutMean, float& OutStdDev)
+{
+    FArrayStatistics Stats;
+    ComputeStatistics(Values.GetData(), Values.Num(), Stats);
+    Normalize(Values.GetData(), Values.Num(), Stats, EArrayNormalization::ZScore, Values.GetData());
+    OutMean = Stats.Mean;
+    OutStdDev = Stats.StdDev;
+}
+
+void UArrayStatisticsBPLibrary::NormalizeMinMaxInPlace(TArray<float>& Values, float& OutMin, float& OutMax)
+{
+    FArrayStatistics Stats;
+    ComputeStatistics(Values.GetData(), Values.Num(), Stats);
+    Normalize(Values.GetData(), Values.Num(), Stats, EArrayNormalization::MinMax, Values.GetData());
+    OutMin = Stats.Min;
+    OutMax = Stats.Max;
+}
+
+void UArrayStatisticsBPLibrary::StatisticsAndNormalize(const TArray<float>& Values, EArrayNormalization Mode, TArray<float>& OutValues, FArrayStatistics& OutStatistics)
+{
+    ComputeStatistics(Values.GetData(), Values.Num(), OutStatistics);
+    if (&OutValues != &Values)
+    {
+        OutValues.SetNumUninitialized(Values.Num());
+    }
+    Normalize(Values.GetData(), Values.Num(), OutStatistics, Mode, OutValues.GetData());
+}
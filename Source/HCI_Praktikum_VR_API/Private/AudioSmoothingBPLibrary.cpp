@@ -4,6 +4,7 @@
 
 #include "AudioSmoothingBPLibrary.h"
 #include "Math/UnrealMathUtility.h"
+#include "AudioVectorMath.h"
 
 void UAudioSmoothingBPLibrary::SMA_Smooth(
     const TArray<float>& InBuffer,
@@ -81,3 +82,84 @@ void UAudioSmoothingBPLibrary::PulseEnhance_Smooth(
     // 4) power-law warp
     OutEnhanced = FMath::Pow(Ratio, Gamma);
 }
+
+void UAudioSmoothingBPLibrary::EMA_SmoothArray(
+    const TArray<float>& NewSamples,
+    float Alpha,
+    TArray<float>& InOutPrevSmoothed,
+    TArray<float>& OutSmoothed)
+{
+    const int32 Num = NewSamples.Num();
+    InOutPrevSmoothed.SetNumZeroed(Num);
+    OutSmoothed.SetNumUninitialized(Num);
+
+    const float* In = NewSamples.GetData();
+    float* State = InOutPrevSmoothed.GetData();
+    float* Out = OutSmoothed.GetData();
+
+    // y = prev + a * (x - prev), same as a*x + (1-a)*prev
+    const VectorRegister4Float AlphaV = VectorSetFloat1(Alpha);
+    int32 i = 0;
+    for (; i + 4 <= Num; i += 4)
+    {
+        const VectorRegister4Float Prev = VectorLoad(State + i);
+        const VectorRegister4Float Y = VectorMultiplyAdd(AlphaV, VectorSubtract(VectorLoad(In + i), Prev), Prev);
+        VectorStore(Y, State + i);
+        VectorStore(Y, Out + i);
+    }
+    for (; i < Num; ++i)
+    {
+        State[i] = Alpha * In[i] + (1.f - Alpha) * State[i];
+        Out[i] = State[i];
+    }
+}
+
+void UAudioSmoothingBPLibrary::PulseEnhance_SmoothArray(
+    const TArray<float>& NewSamples,
+    float BaselineAlpha,
+    float MinRatio,
+    float MaxRatio,
+    float Gamma,
+    TArray<float>& InOutPrevBaseline,
+    TArray<float>& OutEnhanced)
+{
+    const int32 Num = NewSamples.Num();
+    InOutPrevBaseline.SetNumZeroed(Num);
+    OutEnhanced.SetNumUninitialized(Num);
+
+    const float* In = NewSamples.GetData();
+    float* State = InOutPrevBaseline.GetData();
+    float* Out = OutEnhanced.GetData();
+
+    // Ratios at or below MinRatio map to 0, also when MaxRatio <= MinRatio.
+    const float InvRange = (MaxRatio > MinRatio) ? 1.f / (MaxRatio - MinRatio) : 0.f;
+
+    const VectorRegister4Float AlphaV = VectorSetFloat1(BaselineAlpha);
+    const VectorRegister4Float FloorV = VectorSetFloat1(KINDA_SMALL_NUMBER);
+    const VectorRegister4Float MinV = VectorSetFloat1(MinRatio);
+    const VectorRegister4Float MaxV = VectorSetFloat1(FMath::Max(MaxRatio, MinRatio));
+    const VectorRegister4Float InvRangeV = VectorSetFloat1(InvRange);
+    const VectorRegister4Float GammaV = VectorSetFloat1(Gamma);
+
+    int32 i = 0;
+    for (; i + 4 <= Num; i += 4)
+    {
+        const VectorRegister4Float X = VectorLoad(In + i);
+        const VectorRegister4Float Prev = VectorLoad(State + i);
+        const VectorRegister4Float Baseline = VectorMultiplyAdd(AlphaV, VectorSubtract(X, Prev), Prev);
+        VectorStore(Baseline, State + i);
+
+        VectorRegister4Float Ratio = VectorDivide(X, VectorMax(Baseline, FloorV));
+        Ratio = VectorMin(VectorMax(Ratio, MinV), MaxV);
+        Ratio = VectorMultiply(VectorSubtract(Ratio, MinV), InvRangeV);
+
+        VectorStore(AudioVectorMath::VectorFastPow(Ratio, GammaV), Out + i);
+    }
+    for (; i < Num; ++i)
+    {
+        State[i] = BaselineAlpha * In[i] + (1.f - BaselineAlpha) * State[i];
+        float Ratio = In[i] / FMath::Max(State[i], KINDA_SMALL_NUMBER);
+        Ratio = FMath::Clamp(Ratio, MinRatio, FMath::Max(MaxRatio, MinRatio));
+        Out[i] = AudioVectorMath::FastPow((Ratio - MinRatio) * InvRange, Gamma);
+    }
+}
@@ -0,0 +1,183 @@
+// BandQuantileTracker.cpp
+
+#include "BandQuantileTracker.h"
+
+namespace BandQuantileTracker
+{
+    // Renormalize before the insert weight loses float headroom, and now and then
+    // anyway so rounding in the running sums cannot build up.
+    constexpr float MaxInsertWeight = 1e12f;
+    constexpr int32 MaxFramesBetweenRenormalize = 4096;
+
+    /**
+     * floor((log2(Value) - MinLog2) * BinsPerOctave) without a log: the exponent
+     * gives the octave, three mantissa compares the quarter inside it.
+     */
+    static int32 BinOf(float Value)
+    {
+        static_assert(FBandQuantileTracker::BinsPerOctave == 4.f, "BinOf splits octaves into quarters");
+        const uint32 Bits = FPlatformMath::AsUInt(FMath::Max(Value, 1e-30f));
+        const int32 Octave = int32((Bits >> 23) & 0xff) - 127;
+        const float Mantissa = FPlatformMath::AsFloat((Bits & 0x007fffffu) | 0x3f800000u);
+        const int32 Quarter = int32(Mantissa >= 1.18920712f) + int32(Mantissa >= 1.41421356f) + int32(Mantissa >= 1.68179283f);
+        const int32 Bin = (Octave - int32(FBandQuantileTracker::MinLog2)) * 4 + Quarter;
+        return FMath::Clamp(Bin, 0, FBandQuantileTracker::NumBins - 1);
+    }
+
+    /** Bin centre values. */
+    static const float* GetBinValues()
+    {
+        static const TArray<float> Values = []()
+        {
+            TArray<float> Result;
+            Result.SetNumUninitialized(FBandQuantileTracker::NumBins);
+            for (int32 i = 0; i < Result.Num(); ++i)
+            {
+                Result[i] = FMath::Exp2(FBandQuantileTracker::MinLog2 + (float(i) + 0.5f) / FBandQuantileTracker::BinsPerOctave);
+            }
+            return Result;
+        }();
+        return Values.GetData();
+    }
+}
+
+void FBandQuantileTracker::Init(int32 InNumBands, float InLowQuantile, float InHighQuantile, float InDecay)
+{
+    NumBands = FMath::Max(0, InNumBands);
+    SetQuantiles(InLowQuantile, InHighQuantile);
+    SetDecay(InDecay);
+    Reset();
+}
+
+void FBandQuantileTracker::Reset()
+{
+    Histogram.Init(0.f, NumBins * NumBands);
+    LowCursor.Init(FCursor(), NumBands);
+    HighCursor.Init(FCursor(), NumBands);
+    Low.Init(0.f, NumBands);
+    High.Init(0.f, NumBands);
+    InsertWeight = 1.f;
+    TotalWeight = 0.f;
+    FramesSinceRenormalize = 0;
+}
+
+void FBandQuantileTracker::ResizeBands(int32 InNumBands)
+{
+    const int32 OldBands = NumBands;
+    const TArray<float> OldHistogram = MoveTemp(Histogram);
+    const TArray<float> OldLow = MoveTemp(Low);
+    const TArray<float> OldHigh = MoveTemp(High);
+
+    NumBands = FMath::Max(0, InNumBands);
+    Histogram.Init(0.f, NumBins * NumBands);
+    LowCursor.Init(FCursor(), NumBands);
+    HighCursor.Init(FCursor(), NumBands);
+    Low.Init(0.f, NumBands);
+    High.Init(0.f, NumBands);
+
+    if (OldBands == 0)
+    {
+        InsertWeight = 1.f;
+        TotalWeight = 0.f;
+        return;
+    }
+
+    for (int32 b = 0; b < NumBands; ++b)
+    {
+        const int32 Src = FMath::Min(OldBands - 1, (b * OldBands) / FMath::Max(1, NumBands));
+        FMemory::Memcpy(Histogram.GetData() + b * NumBins, OldHistogram.GetData() + Src * NumBins, NumBins * sizeof(float));
+        Low[b] = OldLow[Src];
+        High[b] = OldHigh[Src];
+    }
+    Renormalize();
+}
+
+void FBandQuantileTracker::SetQuantiles(float InLowQuantile, float InHighQuantile)
+{
+    LowQuantile = FMath::Clamp(InLowQuantile, 0.f, 1.f);
+    HighQuantile = FMath::Clamp(InHighQuantile, LowQuantile, 1.f);
+}
+
+void FBandQuantileTracker::Seek(const float* Bins, FCursor& Cursor, float Target)
+{
+    while (Cursor.Bin < NumBins - 1 && Cursor.Below + Bins[Cursor.Bin] < Target)
+    {
+        Cursor.Below += Bins[Cursor.Bin];
+        ++Cursor.Bin;
+    }
+    while (Cursor.Bin > 0 && Cursor.Below >= Target)
+    {
+        --Cursor.Bin;
+        Cursor.Below = FMath::Max(0.f, Cursor.Below - Bins[Cursor.Bin]);
+    }
+}
+
+void FBandQuantileTracker::Renormalize()
+{
+    const float Scale = InsertWeight > 0.f ? 1.f / InsertWeight : 1.f;
+    for (float& Bin : Histogram)
+    {
+        Bin *= Scale;
+    }
+    TotalWeight *= Scale;
+    InsertWeight = 1.f;
+    FramesSinceRenormalize = 0;
+
+    // Exact prefix sums; the cursors then only have to move from bin 0
+    for (int32 b = 0; b < NumBands; ++b)
+    {
+        const float* Bins = Histogram.GetData() + b * NumBins;
+        LowCursor[b] = FCursor();
+        HighCursor[b] = FCursor();
+        Seek(Bins, LowCursor[b], LowQuantile * TotalWeight);
+        Seek(Bins, HighCursor[b], HighQuantile * TotalWeight);
+    }
+}
+
+void FBandQuantileTracker::Update(const float* Values)
+{
+    using namespace BandQuantileTracker;
+
+    if (NumBands == 0)
+    {
+        return;
+    }
+
+    // Decaying everything by Decay is the same as weighting this frame by 1/Decay more.
+    const float Growth = 1.f / FMath::Max(Decay, KINDA_SMALL_NUMBER);
+    if (InsertWeight * Growth > MaxInsertWeight || ++FramesSinceRenormalize > MaxFramesBetweenRenormalize)
+    {
+        Renormalize();
+    }
+    InsertWeight *= Growth;
+    const float Weight = InsertWeight * (1.f - Decay);
+    TotalWeight += Weight;
+
+    const float* BinValues = GetBinValues();
+    const float LowTarget = LowQuantile * TotalWeight;
+    const float HighTarget = HighQuantile * TotalWeight;
+
+    for (int32 b = 0; b < NumBands; ++b)
+    {
+        const int32 Bin = BinOf(Values[b]);
+
+        float* Bins = Histogram.GetData() + b * NumBins;
+        Bins[Bin] += Weight;
+
+        FCursor& LowC = LowCursor[b];
+        FCursor& HighC = HighCursor[b];
+        if (Bin < LowC.Bin)
+        {
+            LowC.Below += Weight;
+        }
+        if (Bin < HighC.Bin)
+        {
+            HighC.Below += Weight;
+        }
+        Seek(Bins, LowC, LowTarget);
+        Seek(Bins, HighC, HighTarget);
+
+        Low[b] = BinValues[LowC.Bin];
+        High[b] = BinValues[HighC.Bin];
+    }
+}
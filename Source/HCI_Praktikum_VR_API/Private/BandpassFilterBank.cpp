@@ -0,0 +1,98 @@
+// BandpassFilterBank.cpp
+
+#include "BandpassFilterBank.h"
+
+void FBandpassFilterBank::Init(float InSampleRate, const TArray<float>& BandEdgesHz, float SmoothingMs)
+{
+    SampleRate = InSampleRate;
+    NumBands = FMath::Max(0, BandEdgesHz.Num() - 1);
+    SmoothCoef = VectorSetFloat1(1.f - FMath::Exp(-1000.f / (FMath::Max(SmoothingMs, 0.1f) * SampleRate)));
+
+    Groups.SetNum(FMath::DivideAndRoundUp(NumBands, 4));
+
+    for (int32 g = 0; g < Groups.Num(); ++g)
+    {
+        alignas(16) float B0[4] = {}, B2[4] = {}, A1[4] = {}, A2[4] = {};
+        for (int32 Lane = 0; Lane < 4; ++Lane)
+        {
+            const int32 b = g * 4 + Lane;
+            if (b >= NumBands)
+            {
+                continue; // padded lanes stay silent
+            }
+
+            // RBJ bandpass (0 dB peak) centred geometrically in the band.
+            const float Lo = FMath::Max(BandEdgesHz[b], 20.f);
+            const float Hi = FMath::Clamp(BandEdgesHz[b + 1], Lo * 1.05f, 0.49f * SampleRate);
+            const float Centre = FMath::Sqrt(Lo * Hi);
+            const float Q = Centre / (Hi - Lo);
+            const float W0 = 2.f * PI * Centre / SampleRate;
+            const float Alpha = FMath::Sin(W0) / (2.f * Q);
+            const float InvA0 = 1.f / (1.f + Alpha);
+
+            B0[Lane] = Alpha * InvA0;
+            B2[Lane] = -Alpha * InvA0;
+            A1[Lane] = -2.f * FMath::Cos(W0) * InvA0;
+            A2[Lane] = (1.f - Alpha) * InvA0;
+        }
+
+        FGroup& Group = Groups[g];
+        Group.B0 = VectorLoadAligned(B0);
+        Group.B2 = VectorLoadAligned(B2);
+        Group.A1 = VectorLoadAligned(A1);
+        Group.A2 = VectorLoadAligned(A2);
+    }
+
+    Reset();
+}
+
+void FBandpassFilterBank::Reset()
+{
+    for (FGroup& Group : Groups)
+    {
+        Group.Z1 = VectorZeroFloat();
+        Group.Z2 = VectorZeroFloat();
+        Group.Power = VectorZeroFloat();
+    }
+}
+
+void FBandpassFilterBank::Process(const float* Samples, int32 NumSamples)
+{
+    for (FGroup& Group : Groups)
+    {
+        // Keep the group's state in registers for the whole block.
+        VectorRegister4Float Z1 = Group.Z1;
+        VectorRegister4Float Z2 = Group.Z2;
+        VectorRegister4Float Power = Group.Power;
+
+        for (int32 n = 0; n < NumSamples; ++n)
+        {
+            const VectorRegister4Float X = VectorSetFloat1(Samples[n]);
+
+            // Transposed direct form II with B1 = 0.
+            const VectorRegister4Float Y = VectorMultiplyAdd(Group.B0, X, Z1);
+            Z1 = VectorNegateMultiplyAdd(Group.A1, Y, Z2);
+            Z2 = VectorNegateMultiplyAdd(Group.A2, Y, VectorMultiply(Group.B2, X));
+
+            // One-pole power follower.
+            Power = VectorMultiplyAdd(SmoothCoef, VectorSubtract(VectorMultiply(Y, Y), Power), Power);
+        }
+
+        Group.Z1 = Z1;
+        Group.Z2 = Z2;
+        Group.Power = Power;
+    }
+}
+
+void FBandpassFilterBank::GetLevels(float* OutLevels) const
+{
+    for (int32 g = 0; g < Groups.Num(); ++g)
+    {
+        alignas(16) float Power[4];
+        VectorStoreAligned(Groups[g].Power, Power);
+        for (int32 Lane = 0; Lane < 4 && g * 4 + Lane < NumBands; ++Lane)
+        {
+            OutLevels[g * 4 + Lane] = FMath::Sqrt(FMath::Max(Power[Lane], 0.f));
+        }
+    }
+}
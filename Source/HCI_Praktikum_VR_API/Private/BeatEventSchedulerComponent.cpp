@@ -0,0 +1,254 @@
+// BeatEventSchedulerComponent.cpp
+
+#include "BeatEventSchedulerComponent.h"
+#include "StreamingSongComponent.h"
+#include "DecodedPcmCache.h"
+#include "OfflineSpectrogram.h"
+#include "NiagaraComponent.h"
+#include "Async/Async.h"
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogBeatScheduler, Log, All);
+
+UBeatEventSchedulerComponent::UBeatEventSchedulerComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = true;
+    // Start of the frame, before anything that reads the Niagara parameters.
+    PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UBeatEventSchedulerComponent::BeginPlay()
+{
+    Super::BeginPlay();
+    Clock = ReadAudioClock();
+    Resync(Clock);
+}
+
+double UBeatEventSchedulerComponent::ReadAudioClock() const
+{
+    if (StreamingSong)
+    {
+        return StreamingSong->GetPlaybackTimeSeconds();
+    }
+    const UWorld* World = GetWorld();
+    return World ? World->GetTimeSeconds() : 0.0;
+}
+
+void UBeatEventSchedulerComponent::Resync(double Now)
+{
+    // The wheel is rebuilt from scratch, so nothing is filed for cancelled or skipped events anymore.
+    Wheel.Init(WheelTickSeconds, Now);
+    for (int32 i = 0; i < Events.Num(); ++i)
+    {
+        if (EventSlots[i] == EEventSlot::Pending && Events[i].AudioTime >= Now)
+        {
+            Wheel.Schedule(Events[i].AudioTime, i);
+        }
+        else if (EventSlots[i] != EEventSlot::Free)
+        {
+            FreeEvent(i);
+        }
+    }
+}
+
+void UBeatEventSchedulerComponent::FreeEvent(int32 Index)
+{
+    EventSlots[Index] = EEventSlot::Free;
+    FreeEvents.Add(Index);
+}
+
+void UBeatEventSchedulerComponent::ScheduleEvent(FName EventName, float AudioTime, float Value)
+{
+    // Past events are not fired late.
+    if (AudioTime < Clock)
+    {
+        return;
+    }
+
+    int32 Index;
+    if (FreeEvents.Num() > 0)
+    {
+        Index = FreeEvents.Pop(false);
+    }
+    else
+    {
+        Index = Events.AddDefaulted();
+        EventSlots.Add(EEventSlot::Free);
+    }
+
+    FBeatVisualEvent& Event = Events[Index];
+    Event = FBeatVisualEvent();
+    Event.EventName = EventName;
+    Event.AudioTime = AudioTime;
+    Event.Value = Value;
+    EventSlots[Index] = EEventSlot::Pending;
+    Wheel.Schedule(AudioTime, Index);
+}
+
+void UBeatEventSchedulerComponent::ScheduleBeats(FName EventName, const TArray<float>& AudioTimes, float Value)
+{
+    Events.Reserve(Events.Num() - FreeEvents.Num() + AudioTimes.Num());
+    EventSlots.Reserve(Events.Max());
+    for (const float Time : AudioTimes)
+    {
+        ScheduleEvent(EventName, Time, Value);
+    }
+}
+
+void UBeatEventSchedulerComponent::ScheduleCachedOnsets(FName EventName, int32 FrameSize, int32 HopSize)
+{
+    if (!StreamingSong || StreamingSong->GetContentHash().IsEmpty())
+    {
+        UE_LOG(LogBeatScheduler, Warning, TEXT("ScheduleCachedOnsets: no song is open."));
+        return;
+    }
+
+    const FString Hash = StreamingSong->GetContentHash();
+    TWeakObjectPtr<UBeatEventSchedulerComponent> WeakThis(this);
+    Async(EAsyncExecution::ThreadPool, [WeakThis, Hash, EventName, FrameSize, HopSize]()
+        {
+            TArray<float> Times;
+            FMappedDecodedPcm Pcm;
+            FOfflineSpectrogram Spectrogram;
+            if (Pcm.Open(FDecodedPcmCache::GetCachePath(Hash), Hash)
+                && Spectrogram.LoadOrCompute(Hash, Pcm, FrameSize, HopSize))
+            {
+                TArray<int32> Onsets;
+                Spectrogram.DetectOnsets(Onsets);
+
+                // Frame i covers [i * Hop, i * Hop + FrameSize); place the onset at its centre.
+                Times.Reserve(Onsets.Num());
+                for (const int32 Frame : Onsets)
+                {
+                    Times.Add((float(Frame) * HopSize + 0.5f * FrameSize) / Spectrogram.SampleRate);
+                }
+            }
+
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, EventName, Times = MoveTemp(Times)]()
+                {
+                    if (UBeatEventSchedulerComponent* Self = WeakThis.Get())
+                    {
+                        UE_LOG(LogBeatScheduler, Log, TEXT("Scheduled %d cached onsets as %s."), Times.Num(), *EventName.ToString());
+                        Self->ScheduleBeats(EventName, Times);
+                    }
+                });
+        });
+}
+
+void UBeatEventSchedulerComponent::CancelEvents(FName EventName)
+{
+    for (int32 i = 0; i < Events.Num(); ++i)
+    {
+        if (EventSlots[i] == EEventSlot::Pending && Events[i].EventName == EventName)
+        {
+            EventSlots[i] = EEventSlot::Cancelled;
+        }
+    }
+}
+
+void UBeatEventSchedulerComponent::ClearEvents()
+{
+    Events.Reset();
+    EventSlots.Reset();
+    FreeEvents.Reset();
+    Wheel.Init(WheelTickSeconds, Clock);
+}
+
+void UBeatEventSchedulerComponent::AddNiagaraBinding(UNiagaraComponent* Component, FName EventName)
+{
+    FBeatNiagaraBinding& Binding = NiagaraBindings.AddDefaulted_GetRef();
+    Binding.Component = Component;
+    Binding.EventName = EventName;
+}
+
+void UBeatEventSchedulerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    const double Reported = ReadAudioClock();
+    if (StreamingSong && !StreamingSong->IsPlaying())
+    {
+        // Hold the clock; a new song or a stop rewinds it.
+        if (FMath::Abs(Reported - Clock) > ResyncThresholdSeconds)
+        {
+            Clock = Reported;
+            Resync(Clock);
+        }
+        return;
+    }
+
+    // Extrapolate with the frame time and pull towards the reported clock.
+    const double Predicted = Clock + DeltaTime;
+    const double Error = Reported - Predicted;
+    if (FMath::Abs(Error) > ResyncThresholdSeconds)
+    {
+        Clock = Reported;
+        Resync(Clock);
+    }
+    else
+    {
+        Clock = Predicted + Error * ClockCorrection;
+    }
+
+    Dispatch(Clock);
+}
+
+void UBeatEventSchedulerComponent::Dispatch(double FrameStart)
+{
+    // The coming frame is assumed to last as long as the previous one.
+    const UWorld* World = GetWorld();
+    const double FrameEnd = FrameStart + (World ? World->GetDeltaSeconds() : 0.0);
+
+    DueScratch.Reset();
+    Wheel.Advance(FrameEnd, DueScratch);
+    if (DueScratch.Num() == 0)
+    {
+        return;
+    }
+
+    Batch.Reset(DueScratch.Num());
+    for (const FTimingWheel::FEntry& Entry : DueScratch)
+    {
+        if (EventSlots[Entry.Payload] == EEventSlot::Pending)
+        {
+            FBeatVisualEvent& Event = Batch.Add_GetRef(Events[Entry.Payload]);
+            Event.FrameOffset = float(Entry.Time - FrameStart);
+        }
+        FreeEvent(Entry.Payload);
+    }
+    if (Batch.Num() == 0)
+    {
+        return;
+    }
+
+    for (FBeatNiagaraBinding& Binding : NiagaraBindings)
+    {
+        if (!Binding.Component)
+        {
+            continue;
+        }
+
+        const FBeatVisualEvent* First = nullptr;
+        int32 Matching = 0;
+        for (const FBeatVisualEvent& Event : Batch)
+        {
+            if (Binding.EventName.IsNone() || Binding.EventName == Event.EventName)
+            {
+                First = First ? First : &Event;
+                ++Matching;
+            }
+        }
+        if (Matching == 0)
+        {
+            continue;
+        }
+
+        Binding.Counter += Matching;
+        Binding.Component->SetVariableFloat(Binding.OffsetParameter, First->FrameOffset);
+        Binding.Component->SetVariableFloat(Binding.ValueParameter, First->Value);
+        Binding.Component->SetVariableInt(Binding.CounterParameter, Binding.Counter);
+    }
+
+    OnBeatEvents.Broadcast(Batch);
+}
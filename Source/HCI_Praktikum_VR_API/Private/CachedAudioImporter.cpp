@@ -0,0 +1,136 @@
+// CachedAudioImporter.cpp
+
+#include "CachedAudioImporter.h"
+#include "DecodedPcmCache.h"
+#include "SongLibrarySubsystem.h"
+#include "RuntimeAudioImporterLibrary.h"
+#include "Sound/ImportedSoundWave.h"
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCachedAudioImporter, Log, All);
+
+UCachedAudioImporter* UCachedAudioImporter::CreateCachedAudioImporter()
+{
+    return NewObject<UCachedAudioImporter>();
+}
+
+void UCachedAudioImporter::ImportAudioFromFile(const FString& FilePath)
+{
+    if (bIsImporting)
+    {
+        UE_LOG(LogCachedAudioImporter, Warning, TEXT("Import of %s ignored, %s is still importing."), *FilePath, *CurrentFile);
+        return;
+    }
+
+    if (!Importer)
+    {
+        Importer = URuntimeAudioImporterLibrary::CreateRuntimeAudioImporter();
+        Importer->OnResultNative.AddUObject(this, &UCachedAudioImporter::OnImporterResult);
+    }
+
+    bIsImporting = true;
+    CurrentFile = FilePath;
+    ImportStartTime = FPlatformTime::Seconds();
+
+    const EDecodedPcmFormat WriteFormat = bStoreAsInt16 ? EDecodedPcmFormat::Int16 : EDecodedPcmFormat::Float32;
+    TWeakObjectPtr<UCachedAudioImporter> WeakThis(this);
+
+    Async(EAsyncExecution::ThreadPool, [WeakThis, FilePath, WriteFormat]()
+        {
+            TArray64<uint8> Bytes;
+            if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+            {
+                AsyncTask(ENamedThreads::GameThread, [WeakThis, FilePath]()
+                    {
+                        if (UCachedAudioImporter* Self = WeakThis.Get())
+                        {
+                            Self->Fail(FString::Printf(TEXT("could not read %s"), *FilePath));
+                        }
+                    });
+                return;
+            }
+
+            const FString Hash = USongLibrarySubsystem::HashBuffer(Bytes.GetData(), Bytes.Num());
+
+            // Cache hit: the mapping is the only read of the samples. RuntimeAudioImporter owns
+            // its buffers, so this is one memcpy into its RAW import instead of a full decode.
+            FMappedDecodedPcm Mapped;
+            if (Mapped.Open(FDecodedPcmCache::GetCachePath(Hash), Hash))
+            {
+                const FDecodedPcmHeader Header = Mapped.GetHeader();
+                const TArrayView64<const uint8> View = Mapped.GetBytes();
+                TArray64<uint8> Raw(View.GetData(), View.Num());
+                Mapped.Close();
+
+                AsyncTask(ENamedThreads::GameThread, [WeakThis, Header, Raw = MoveTemp(Raw)]() mutable
+                    {
+                        if (UCachedAudioImporter* Self = WeakThis.Get())
+                        {
+                            Self->bFromCache = true;
+                            const ERuntimeRAWAudioFormat Format = Header.Format == uint8(EDecodedPcmFormat::Int16)
+                                ? ERuntimeRAWAudioFormat::Int16
+                                : ERuntimeRAWAudioFormat::Float32;
+                            Self->Importer->ImportAudioFromRAWBuffer(MoveTemp(Raw), Format, int32(Header.SampleRate), int32(Header.NumChannels));
+                        }
+                    });
+                return;
+            }
+
+            // Cache miss: decode once, persist, and hand the decoded buffer over without another decode.
+            FDecodedAudioStruct Decoded;
+            const ERuntimeAudioFormat Format = URuntimeAudioImporterLibrary::GetAudioFormat(FilePath);
+            if (!URuntimeAudioImporterLibrary::DecodeAudioData(FEncodedAudioStruct(MoveTemp(Bytes), Format), Decoded))
+            {
+                AsyncTask(ENamedThreads::GameThread, [WeakThis, FilePath]()
+                    {
+                        if (UCachedAudioImporter* Self = WeakThis.Get())
+                        {
+                            Self->Fail(FString::Printf(TEXT("could not decode %s"), *FilePath));
+                        }
+                    });
+                return;
+            }
+
+            FDecodedPcmCache::Write(Hash, Decoded.PCMInfo.PCMData.GetView(),
+                Decoded.SoundWaveBasicInfo.SampleRate, Decoded.SoundWaveBasicInfo.NumOfChannels, WriteFormat);
+
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, Decoded = MoveTemp(Decoded)]() mutable
+                {
+                    if (UCachedAudioImporter* Self = WeakThis.Get())
+                    {
+                        Self->bFromCache = false;
+                        Self->Importer->ImportAudioFromDecodedInfo(MoveTemp(Decoded));
+                    }
+                });
+        });
+}
+
+void UCachedAudioImporter::OnImporterResult(URuntimeAudioImporterLibrary* InImporter, UImportedSoundWave* SoundWave, ERuntimeImportStatus Status)
+{
+    if (!bIsImporting)
+    {
+        return;
+    }
+
+    if (Status != ERuntimeImportStatus::SuccessfulImport || !SoundWave)
+    {
+        Fail(FString::Printf(TEXT("RuntimeAudioImporter rejected %s"), *CurrentFile));
+        return;
+    }
+
+    const float Seconds = float(FPlatformTime::Seconds() - ImportStartTime);
+    UE_LOG(LogCachedAudioImporter, Log, TEXT("Imported %s in %.1f ms (%s)."),
+        *CurrentFile, Seconds * 1000.0f, bFromCache ? TEXT("PCM cache hit") : TEXT("decoded, cache written"));
+
+    bIsImporting = false;
+    OnImported.Broadcast(SoundWave, bFromCache, Seconds);
+}
+
+void UCachedAudioImporter::Fail(const FString& Reason)
+{
+    UE_LOG(LogCachedAudioImporter, Warning, TEXT("Import failed: %s"), *Reason);
+    bIsImporting = false;
+    OnImported.Broadcast(nullptr, false, float(FPlatformTime::Seconds() - ImportStartTime));
+}
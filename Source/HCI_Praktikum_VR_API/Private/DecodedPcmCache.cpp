@@ -0,0 +1,210 @@
+// DecodedPcmCache.cpp
+
+#include "DecodedPcmCache.h"
+#include "SongLibrarySubsystem.h"
+#include "RuntimeAudioImporterLibrary.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogDecodedPcmCache, Log, All);
+
+bool FDecodedPcmHeader::IsValidFor(const FString& ExpectedHash, uint64 FileSize) const
+{
+    const FString StoredHash(16, ContentHash);
+    return Magic == ExpectedMagic
+        && Version == CurrentVersion
+        && NumChannels > 0
+        && SampleRate > 0
+        && Format <= uint8(EDecodedPcmFormat::Int16)
+        && StoredHash.Equals(ExpectedHash, ESearchCase::IgnoreCase)
+        && FileSize >= sizeof(FDecodedPcmHeader) + GetDataSize();
+}
+
+FMappedDecodedPcm::FMappedDecodedPcm() = default;
+
+FMappedDecodedPcm::~FMappedDecodedPcm()
+{
+    Close();
+}
+
+bool FMappedDecodedPcm::Open(const FString& Path, const FString& ExpectedHash)
+{
+    Close();
+
+    Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path));
+    if (!Handle.IsValid())
+    {
+        return false;
+    }
+
+    Region.Reset(Handle->MapRegion(0, Handle->GetFileSize()));
+    if (!Region.IsValid() || Region->GetMappedSize() < int64(sizeof(FDecodedPcmHeader)))
+    {
+        Close();
+        return false;
+    }
+
+    FMemory::Memcpy(&Header, Region->GetMappedPtr(), sizeof(FDecodedPcmHeader));
+
+    if (!Header.IsValidFor(ExpectedHash, uint64(Region->GetMappedSize())))
+    {
+        UE_LOG(LogDecodedPcmCache, Warning, TEXT("Ignoring stale or corrupt PCM cache %s"), *Path);
+        Close();
+        return false;
+    }
+
+    Data = Region->GetMappedPtr() + sizeof(FDecodedPcmHeader);
+    return true;
+}
+
+void FMappedDecodedPcm::Close()
+{
+    Data = nullptr;
+    Region.Reset();
+    Handle.Reset();
+    Header = FDecodedPcmHeader();
+}
+
+TArrayView64<const uint8> FMappedDecodedPcm::GetBytes() const
+{
+    return Data ? TArrayView64<const uint8>(Data, int64(Header.GetDataSize())) : TArrayView64<const uint8>();
+}
+
+TArrayView64<const float> FMappedDecodedPcm::GetFloatSamples() const
+{
+    if (!Data || GetFormat() != EDecodedPcmFormat::Float32)
+    {
+        return TArrayView64<const float>();
+    }
+    return TArrayView64<const float>(reinterpret_cast<const float*>(Data), int64(Header.NumFrames * Header.NumChannels));
+}
+
+TArrayView64<const int16> FMappedDecodedPcm::GetInt16Samples() const
+{
+    if (!Data || GetFormat() != EDecodedPcmFormat::Int16)
+    {
+        return TArrayView64<const int16>();
+    }
+    return TArrayView64<const int16>(reinterpret_cast<const int16*>(Data), int64(Header.NumFrames * Header.NumChannels));
+}
+
+int64 FMappedDecodedPcm::ReadFloat(int64 StartSample, float* Out, int64 Num) const
+{
+    const int64 Total = int64(Header.NumFrames * Header.NumChannels);
+    const int64 Count = FMath::Clamp<int64>(Total - StartSample, 0, Num);
+    if (!Data || Count == 0)
+    {
+        return 0;
+    }
+
+    if (GetFormat() == EDecodedPcmFormat::Float32)
+    {
+        FMemory::Memcpy(Out, reinterpret_cast<const float*>(Data) + StartSample, Count * sizeof(float));
+    }
+    else
+    {
+        const int16* Src = reinterpret_cast<const int16*>(Data) + StartSample;
+        constexpr float Scale = 1.0f / 32768.0f;
+        for (int64 i = 0; i < Count; ++i)
+        {
+            Out[i] = Src[i] * Scale;
+        }
+    }
+    return Count;
+}
+
+FString FDecodedPcmCache::GetCachePath(const FString& ContentHash)
+{
+    return USongLibrarySubsystem::GetAnalysisCacheDir(ContentHash) / TEXT("decoded.pcm");
+}
+
+bool FDecodedPcmCache::Exists(const FString& ContentHash)
+{
+    return !ContentHash.IsEmpty() && IFileManager::Get().FileExists(*GetCachePath(ContentHash));
+}
+
+bool FDecodedPcmCache::Write(const FString& ContentHash, TArrayView64<const float> Samples, int32 SampleRate, int32 NumChannels, EDecodedPcmFormat Format)
+{
+    if (ContentHash.Len() != 16 || NumChannels <= 0 || SampleRate <= 0)
+    {
+        return false;
+    }
+
+    FDecodedPcmHeader Header;
+    Header.SampleRate = uint32(SampleRate);
+    Header.NumChannels = uint32(NumChannels);
+    Header.NumFrames = uint64(Samples.Num() / NumChannels);
+    Header.Format = uint8(Format);
+    for (int32 i = 0; i < 16; ++i)
+    {
+        Header.ContentHash[i] = ANSICHAR(ContentHash[i]);
+    }
+
+    const int64 NumSamples = int64(Header.NumFrames) * NumChannels;
+    const FString FinalPath = GetCachePath(ContentHash);
+    const FString TempPath = FinalPath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+    if (!Writer)
+    {
+        UE_LOG(LogDecodedPcmCache, Warning, TEXT("Could not create %s"), *TempPath);
+        return false;
+    }
+
+    Writer->Serialize(&Header, sizeof(Header));
+    if (Format == EDecodedPcmFormat::Float32)
+    {
+        Writer->Serialize(const_cast<float*>(Samples.GetData()), NumSamples * sizeof(float));
+    }
+    else
+    {
+        constexpr int64 ChunkSamples = 64 * 1024;
+        TArray<int16> Chunk;
+        Chunk.SetNumUninitialized(ChunkSamples);
+        for (int64 Start = 0; Start < NumSamples; Start += ChunkSamples)
+        {
+            const int64 Count = FMath::Min(ChunkSamples, NumSamples - Start);
+            for (int64 i = 0; i < Count; ++i)
+            {
+                Chunk[i] = int16(FMath::Clamp(FMath::RoundToInt(Samples[Start + i] * 32767.0f), -32768, 32767));
+            }
+            Writer->Serialize(Chunk.GetData(), Count * sizeof(int16));
+        }
+    }
+
+    const bool bOk = Writer->Close() && !Writer->IsError();
+    Writer.Reset();
+
+    if (!bOk || !IFileManager::Get().Move(*FinalPath, *TempPath, true, true))
+    {
+        UE_LOG(LogDecodedPcmCache, Warning, TEXT("Could not write PCM cache %s"), *FinalPath);
+        IFileManager::Get().Delete(*TempPath, false, false, true);
+        return false;
+    }
+    return true;
+}
+
+bool FDecodedPcmCache::DecodeFileToCache(const FString& FilePath, const FString& ContentHash, EDecodedPcmFormat Format)
+{
+    TArray64<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+    {
+        UE_LOG(LogDecodedPcmCache, Warning, TEXT("Could not read %s"), *FilePath);
+        return false;
+    }
+
+    FDecodedAudioStruct Decoded;
+    const ERuntimeAudioFormat AudioFormat = URuntimeAudioImporterLibrary::GetAudioFormat(FilePath);
+    if (!URuntimeAudioImporterLibrary::DecodeAudioData(FEncodedAudioStruct(MoveTemp(Bytes), AudioFormat), Decoded))
+    {
+        UE_LOG(LogDecodedPcmCache, Warning, TEXT("Could not decode %s"), *FilePath);
+        return false;
+    }
+
+    return Write(ContentHash, Decoded.PCMInfo.PCMData.GetView(),
+        Decoded.SoundWaveBasicInfo.SampleRate, Decoded.SoundWaveBasicInfo.NumOfChannels, Format);
+}
@@ -0,0 +1,89 @@
+// FeatureSmoothingComponent.cpp
+
+#include "FeatureSmoothingComponent.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFeatureSmoothingComponent, Log, All);
+
+UFeatureSmoothingComponent::UFeatureSmoothingComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UFeatureSmoothingComponent::BeginPlay()
+{
+    Super::BeginPlay();
+    SetPipeline(Pipeline);
+}
+
+void UFeatureSmoothingComponent::SetPipeline(UFeatureSmoothingPipelineAsset* InPipeline)
+{
+    Pipeline = InPipeline;
+    WarnedMissingFeatures.Reset();
+    if (Pipeline)
+    {
+        Pipeline->Compile(Program);
+    }
+    else
+    {
+        Program.Compile({});
+    }
+}
+
+int32 UFeatureSmoothingComponent::FindFeatureChecked(FName FeatureName) const
+{
+    const int32 Feature = Program.FindFeature(FeatureName);
+    if (Feature == INDEX_NONE)
+    {
+        bool bAlreadyWarned = false;
+        WarnedMissingFeatures.Add(FeatureName, &bAlreadyWarned);
+        UE_CLOG(!bAlreadyWarned, LogFeatureSmoothingComponent, Warning, TEXT("%s: feature %s is not in the pipeline."), *GetNameSafe(GetOwner()), *FeatureName.ToString());
+    }
+    return Feature;
+}
+
+void UFeatureSmoothingComponent::SetFeatureValue(FName FeatureName, float Value)
+{
+    const int32 Feature = FindFeatureChecked(FeatureName);
+    if (Feature != INDEX_NONE)
+    {
+        Program.GetInputLanes(Feature)[0] = Value;
+    }
+}
+
+void UFeatureSmoothingComponent::SetFeatureArray(FName FeatureName, const TArray<float>& Values)
+{
+    const int32 Feature = FindFeatureChecked(FeatureName);
+    if (Feature != INDEX_NONE)
+    {
+        TArrayView<float> Lanes = Program.GetInputLanes(Feature);
+        FMemory::Memcpy(Lanes.GetData(), Values.GetData(), FMath::Min(Lanes.Num(), Values.Num()) * sizeof(float));
+    }
+}
+
+void UFeatureSmoothingComponent::Process()
+{
+    Program.Execute();
+}
+
+float UFeatureSmoothingComponent::GetFeatureValue(FName FeatureName, int32 Band) const
+{
+    const int32 Feature = FindFeatureChecked(FeatureName);
+    if (Feature == INDEX_NONE || Band < 0 || Band >= Program.GetNumBands(Feature))
+    {
+        return 0.f;
+    }
+    return Program.GetLanes(Feature)[Band];
+}
+
+void UFeatureSmoothingComponent::GetFeatureArray(FName FeatureName, TArray<float>& OutValues) const
+{
+    const int32 Feature = FindFeatureChecked(FeatureName);
+    if (Feature == INDEX_NONE)
+    {
+        OutValues.Reset();
+        return;
+    }
+    const TConstArrayView<float> Lanes = Program.GetLanes(Feature);
+    OutValues.Reset(Lanes.Num());
+    OutValues.Append(Lanes.GetData(), Lanes.Num());
+}
@@ -0,0 +1,215 @@
+// FeatureSmoothingPipelineAsset.cpp
+
+#include "FeatureSmoothingPipelineAsset.h"
+#include "AudioVectorMath.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFeatureSmoothing, Log, All);
+
+void FFeatureSmoothingProgram::Compile(const TArray<FFeatureSmoothingPipeline>& Pipelines)
+{
+    Features.Reset();
+    Instructions.Reset();
+    Medians.Reset();
+
+    int32 NumLanesTotal = 0;
+    int32 StateSize = 0;
+    int32 CounterSize = 0;
+
+    for (const FFeatureSmoothingPipeline& Pipeline : Pipelines)
+    {
+        if (FindFeature(Pipeline.FeatureName) != INDEX_NONE)
+        {
+            UE_LOG(LogFeatureSmoothing, Warning, TEXT("Feature %s is defined twice; only the first definition is used."), *Pipeline.FeatureName.ToString());
+            continue;
+        }
+
+        FFeatureLayout& Layout = Features.AddDefaulted_GetRef();
+        Layout.Name = Pipeline.FeatureName;
+        Layout.FirstLane = NumLanesTotal;
+        Layout.NumLanes = FMath::Max(1, Pipeline.NumBands);
+        NumLanesTotal += Layout.NumLanes;
+
+        for (const FFeatureSmoothingStage& Stage : Pipeline.Stages)
+        {
+            FInstruction Inst = {};
+            Inst.Op = Stage.Op;
+            Inst.FirstLane = Layout.FirstLane;
+            Inst.NumLanes = Layout.NumLanes;
+            Inst.StateOffset = StateSize;
+            Inst.CounterOffset = CounterSize;
+            Inst.Window = FMath::Max(1, Stage.Window);
+            Inst.MedianIndex = INDEX_NONE;
+
+            switch (Stage.Op)
+            {
+            case EFeatureSmoothingOp::EMA:
+                Inst.P0 = Stage.Alpha;
+                StateSize += Inst.NumLanes;
+                break;
+            case EFeatureSmoothingOp::MovingAverage:
+                // Sum + Kahan compensation per lane, then the ring [Slot][Lane].
+                StateSize += Inst.NumLanes * (2 + Inst.Window);
+                CounterSize += 2;
+                break;
+            case EFeatureSmoothingOp::Median:
+                Inst.MedianIndex = Medians.AddDefaulted();
+                Medians[Inst.MedianIndex].Init(Inst.NumLanes, Inst.Window);
+                break;
+            case EFeatureSmoothingOp::MaxNormalize:
+                Inst.P0 = Stage.Decay;
+                StateSize += Inst.NumLanes;
+                break;
+            case EFeatureSmoothingOp::Standardize:
+                Inst.P0 = Stage.Alpha;
+                StateSize += Inst.NumLanes * 2;
+                break;
+            case EFeatureSmoothingOp::PulseEnhance:
+                Inst.P0 = Stage.Alpha;
+                Inst.P1 = Stage.MinRatio;
+                Inst.P2 = FMath::Max(Stage.MaxRatio, Stage.MinRatio);
+                Inst.P3 = Stage.Gamma;
+                StateSize += Inst.NumLanes;
+                break;
+            case EFeatureSmoothingOp::Scale:
+                Inst.P0 = Stage.Gain;
+                Inst.P1 = Stage.Offset;
+                break;
+            case EFeatureSmoothingOp::Clamp:
+                Inst.P0 = Stage.ClampMin;
+                Inst.P1 = FMath::Max(Stage.ClampMax, Stage.ClampMin);
+                break;
+            }
+
+            Instructions.Add(Inst);
+        }
+    }
+
+    // SetNumZeroed keeps old contents when shrinking; a new program starts from zero.
+    Inputs.Reset();
+    Inputs.SetNumZeroed(NumLanesTotal);
+    Lanes.Reset();
+    Lanes.SetNumZeroed(NumLanesTotal);
+    State.Reset();
+    State.SetNumZeroed(StateSize);
+    Counters.Reset();
+    Counters.SetNumZeroed(CounterSize);
+}
+
+void FFeatureSmoothingProgram::Reset()
+{
+    FMemory::Memzero(Inputs.GetData(), Inputs.Num() * sizeof(float));
+    FMemory::Memzero(Lanes.GetData(), Lanes.Num() * sizeof(float));
+    FMemory::Memzero(State.GetData(), State.Num() * sizeof(float));
+    FMemory::Memzero(Counters.GetData(), Counters.Num() * sizeof(int32));
+    for (FSlidingMedianBank& Median : Medians)
+    {
+        Median.Reset();
+    }
+}
+
+int32 FFeatureSmoothingProgram::FindFeature(FName FeatureName) const
+{
+    return Features.IndexOfByPredicate([FeatureName](const FFeatureLayout& Layout) { return Layout.Name == FeatureName; });
+}
+
+void FFeatureSmoothingProgram::Execute()
+{
+    // Stages run in place on the output lanes; an input not set this frame is smoothed again from its last raw value.
+    FMemory::Memcpy(Lanes.GetData(), Inputs.GetData(), Lanes.Num() * sizeof(float));
+
+    for (const FInstruction& Inst : Instructions)
+    {
+        float* RESTRICT X = Lanes.GetData() + Inst.FirstLane;
+        float* RESTRICT S = State.GetData() + Inst.StateOffset;
+        const int32 N = Inst.NumLanes;
+
+        switch (Inst.Op)
+        {
+        case EFeatureSmoothingOp::EMA:
+            for (int32 i = 0; i < N; ++i)
+            {
+                S[i] += Inst.P0 * (X[i] - S[i]);
+                X[i] = S[i];
+            }
+            break;
+
+        case EFeatureSmoothingOp::MovingAverage:
+        {
+            int32& Head = Counters[Inst.CounterOffset];
+            int32& Count = Counters[Inst.CounterOffset + 1];
+            float* Sum = S;
+            float* Comp = S + N;
+            float* Slot = S + 2 * N + Head * N;
+            const bool bFull = Count == Inst.Window;
+            Count = bFull ? Count : Count + 1;
+            const float InvCount = 1.f / Count;
+
+            for (int32 i = 0; i < N; ++i)
+            {
+                // Kahan add of (new - oldest); the oldest is 0 while filling.
+                const float Delta = X[i] - (bFull ? Slot[i] : 0.f);
+                const float Y = Delta - Comp[i];
+                const float T = Sum[i] + Y;
+                Comp[i] = (T - Sum[i]) - Y;
+                Sum[i] = T;
+                Slot[i] = X[i];
+                X[i] = Sum[i] * InvCount;
+            }
+            Head = (Head + 1 == Inst.Window) ? 0 : Head + 1;
+            break;
+        }
+
+        case EFeatureSmoothingOp::Median:
+            Medians[Inst.MedianIndex].PushAll(X, X);
+            break;
+
+        case EFeatureSmoothingOp::MaxNormalize:
+            for (int32 i = 0; i < N; ++i)
+            {
+                S[i] = FMath::Max(X[i], S[i] * Inst.P0);
+                X[i] = X[i] / FMath::Max(S[i], KINDA_SMALL_NUMBER);
+            }
+            break;
+
+        case EFeatureSmoothingOp::Standardize:
+        {
+            float* Mean = S;
+            float* Var = S + N;
+            for (int32 i = 0; i < N; ++i)
+            {
+                const float Diff = X[i] - Mean[i];
+                Mean[i] += Inst.P0 * Diff;
+                Var[i] = (1.f - Inst.P0) * (Var[i] + Inst.P0 * Diff * Diff);
+                X[i] = (X[i] - Mean[i]) / FMath::Sqrt(Var[i] + KINDA_SMALL_NUMBER);
+            }
+            break;
+        }
+
+        case EFeatureSmoothingOp::PulseEnhance:
+        {
+            const float InvRange = (Inst.P2 > Inst.P1) ? 1.f / (Inst.P2 - Inst.P1) : 0.f;
+            for (int32 i = 0; i < N; ++i)
+            {
+                S[i] += Inst.P0 * (X[i] - S[i]);
+                const float Ratio = FMath::Clamp(X[i] / FMath::Max(S[i], KINDA_SMALL_NUMBER), Inst.P1, Inst.P2);
+                X[i] = AudioVectorMath::FastPow((Ratio - Inst.P1) * InvRange, Inst.P3);
+            }
+            break;
+        }
+
+        case EFeatureSmoothingOp::Scale:
+            for (int32 i = 0; i < N; ++i)
+            {
+                X[i] = X[i] * Inst.P0 + Inst.P1;
+            }
+            break;
+
+        case EFeatureSmoothingOp::Clamp:
+            for (int32 i = 0; i < N; ++i)
+            {
+                X[i] = FMath::Clamp(X[i], Inst.P0, Inst.P1);
+            }
+            break;
+        }
+    }
+}
@@ -0,0 +1,244 @@
+// FireflyPoolSubsystem.cpp
+
+#include "FireflyPoolSubsystem.h"
+#include "PoolableActor.h"
+#include "ProximityGridSubsystem.h"
+#include "NiagaraComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFireflyPool, Log, All);
+
+const FName UFireflyPoolSubsystem::ProximityLayer(TEXT("Fireflies"));
+
+UFireflyPoolSubsystem* UFireflyPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UFireflyPoolSubsystem>() : nullptr;
+}
+
+void UFireflyPoolSubsystem::Deinitialize()
+{
+    // The world destroys the actors themselves.
+    Pools.Empty();
+    Owned.Empty();
+    Super::Deinitialize();
+}
+
+UFireflyPoolSubsystem::FPool& UFireflyPoolSubsystem::GetPool(UClass* ActorClass)
+{
+    FPool& Pool = Pools.FindOrAdd(ActorClass);
+    if (!Pool.bPropertiesResolved)
+    {
+        Pool.bPropertiesResolved = true;
+        for (TFieldIterator<FNumericProperty> It(ActorClass); It; ++It)
+        {
+            if (It->GetName().StartsWith(TEXT("default_"), ESearchCase::CaseSensitive))
+            {
+                Pool.StatisticProperties.Add(*It);
+            }
+        }
+    }
+
+    // Instances destroyed behind the pool's back
+    Pool.Free.RemoveAllSwap([](const TWeakObjectPtr<AActor>& A) { return !A.IsValid(); });
+    Pool.Active.RemoveAll([](const TWeakObjectPtr<AActor>& A) { return !A.IsValid(); });
+    return Pool;
+}
+
+AActor* UFireflyPoolSubsystem::SpawnParked(UClass* ActorClass, FPool& Pool)
+{
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    AActor* Actor = GetWorld()->SpawnActor<AActor>(ActorClass, FTransform::Identity, SpawnParams);
+    if (!Actor)
+    {
+        UE_LOG(LogFireflyPool, Warning, TEXT("Could not spawn %s."), *GetNameSafe(ActorClass));
+        return nullptr;
+    }
+    Owned.Add(Actor, ActorClass);
+    Park(Actor);
+    return Actor;
+}
+
+void UFireflyPoolSubsystem::Park(AActor* Actor) const
+{
+    Actor->SetActorHiddenInGame(true);
+    Actor->SetActorEnableCollision(false);
+    Actor->SetActorTickEnabled(false);
+
+    if (UProximityGridSubsystem* Proximity = UProximityGridSubsystem::Get(Actor))
+    {
+        Proximity->UnregisterComponent(ProximityLayer, Actor->GetRootComponent());
+    }
+
+    TInlineComponentArray<UNiagaraComponent*> NiagaraComponents(Actor);
+    for (UNiagaraComponent* Component : NiagaraComponents)
+    {
+        Component->DeactivateImmediate();
+    }
+}
+
+void UFireflyPoolSubsystem::Activate(AActor* Actor, FPool& Pool, const FTransform& Transform) const
+{
+    const AActor* Defaults = Actor->GetClass()->GetDefaultObject<AActor>();
+
+    Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+    for (const FProperty* Property : Pool.StatisticProperties)
+    {
+        Property->CopyCompleteValue_InContainer(Actor, Defaults);
+    }
+
+    Actor->SetActorHiddenInGame(Defaults->IsHidden());
+    Actor->SetActorEnableCollision(Defaults->GetActorEnableCollision());
+    Actor->SetActorTickEnabled(Defaults->PrimaryActorTick.bStartWithTickEnabled);
+
+    // Restart from an empty particle state
+    TInlineComponentArray<UNiagaraComponent*> NiagaraComponents(Actor);
+    for (UNiagaraComponent* Component : NiagaraComponents)
+    {
+        if (Component->bAutoActivate)
+        {
+            Component->Activate(true);
+        }
+    }
+
+    if (UProximityGridSubsystem* Proximity = UProximityGridSubsystem::Get(Actor))
+    {
+        Proximity->RegisterActor(ProximityLayer, Actor);
+    }
+
+    if (Actor->Implements<UPoolableActor>())
+    {
+        IPoolableActor::Execute_OnAcquiredFromPool(Actor);
+    }
+}
+
+void UFireflyPoolSubsystem::Prewarm(TSubclassOf<AActor> ActorClass, int32 Count)
+{
+    if (!ActorClass)
+    {
+        return;
+    }
+    FPool& Pool = GetPool(ActorClass);
+    if (Pool.Cap > 0)
+    {
+        Count = FMath::Min(Count, Pool.Cap);
+    }
+    while (Pool.Free.Num() + Pool.Active.Num() < Count)
+    {
+        AActor* Actor = SpawnParked(ActorClass, Pool);
+        if (!Actor)
+        {
+            break;
+        }
+        Pool.Free.Add(Actor);
+    }
+}
+
+void UFireflyPoolSubsystem::SetPoolCap(TSubclassOf<AActor> ActorClass, int32 MaxInstances)
+{
+    if (ActorClass)
+    {
+        GetPool(ActorClass).Cap = FMath::Max(0, MaxInstances);
+    }
+}
+
+AActor* UFireflyPoolSubsystem::AcquireActor(TSubclassOf<AActor> ActorClass, const FTransform& Transform)
+{
+    if (!ActorClass)
+    {
+        return nullptr;
+    }
+    FPool& Pool = GetPool(ActorClass);
+
+    AActor* Actor = Pool.Free.Num() > 0 ? Pool.Free.Pop(false).Get() : nullptr;
+    if (Actor)
+    {
+        ++Pool.Stats.Hits;
+    }
+    else if (Pool.Cap > 0 && Pool.Active.Num() >= Pool.Cap)
+    {
+        // At the cap: take over the oldest active instance
+        Actor = Pool.Active[0].Get();
+        Pool.Active.RemoveAt(0, 1, false);
+        if (Actor->Implements<UPoolableActor>())
+        {
+            IPoolableActor::Execute_OnReleasedToPool(Actor);
+        }
+        Park(Actor);
+        ++Pool.Stats.Recycled;
+    }
+    else
+    {
+        Actor = SpawnParked(ActorClass, Pool);
+        if (!Actor)
+        {
+            return nullptr;
+        }
+        ++Pool.Stats.Misses;
+    }
+
+    Activate(Actor, Pool, Transform);
+    Pool.Active.Add(Actor);
+    Pool.Stats.HighWaterMark = FMath::Max(Pool.Stats.HighWaterMark, Pool.Active.Num());
+    return Actor;
+}
+
+void UFireflyPoolSubsystem::ReleaseActor(AActor* Actor)
+{
+    if (!IsValid(Actor))
+    {
+        return;
+    }
+
+    const TObjectKey<UClass>* ClassKey = Owned.Find(Actor);
+    FPool* Pool = ClassKey ? Pools.Find(*ClassKey) : nullptr;
+    if (!Pool)
+    {
+        Actor->Destroy();
+        return;
+    }
+    if (Pool->Active.RemoveSingle(Actor) == 0)
+    {
+        return; // already parked
+    }
+
+    if (Actor->Implements<UPoolableActor>())
+    {
+        IPoolableActor::Execute_OnReleasedToPool(Actor);
+    }
+    Park(Actor);
+    Pool->Free.Add(Actor);
+}
+
+FActorPoolStats UFireflyPoolSubsystem::GetPoolStats(TSubclassOf<AActor> ActorClass) const
+{
+    const FPool* Pool = ActorClass ? Pools.Find(ActorClass.Get()) : nullptr;
+    if (!Pool)
+    {
+        return FActorPoolStats();
+    }
+    FActorPoolStats Stats = Pool->Stats;
+    Stats.Active = Pool->Active.Num();
+    Stats.Free = Pool->Free.Num();
+    return Stats;
+}
+
+void UFireflyPoolSubsystem::TrimPool(TSubclassOf<AActor> ActorClass)
+{
+    FPool* Pool = ActorClass ? Pools.Find(ActorClass.Get()) : nullptr;
+    if (!Pool)
+    {
+        return;
+    }
+    for (const TWeakObjectPtr<AActor>& Parked : Pool->Free)
+    {
+        if (AActor* Actor = Parked.Get())
+        {
+            Owned.Remove(Actor);
+            Actor->Destroy();
+        }
+    }
+    Pool->Free.Reset();
+}
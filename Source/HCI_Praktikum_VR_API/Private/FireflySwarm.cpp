@@ -0,0 +1,317 @@
+// FireflySwarm.cpp
+
+#include "FireflySwarm.h"
+#include "NiagaraComponent.h"
+#include "NiagaraDataInterfaceArrayFunctionLibrary.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "MelOverbandAnalyzerComponent.h"
+#include "ForceFieldSetComponent.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFireflySwarm, Log, All);
+
+namespace
+{
+    const FName PositionsParameter(TEXT("User.FireflyPositions"));
+    const FName BrightnessParameter(TEXT("User.FireflyBrightness"));
+    const FName CountParameter(TEXT("User.FireflyCount"));
+}
+
+AFireflySwarm::AFireflySwarm()
+{
+    PrimaryActorTick.bCanEverTick = true;
+    // After the actor ticks that run the analyzer and move the force fields.
+    PrimaryActorTick.TickGroup = TG_PostPhysics;
+
+    RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+    SwarmSystem = CreateDefaultSubobject<UNiagaraComponent>(TEXT("SwarmSystem"));
+    SwarmSystem->SetupAttachment(RootComponent);
+
+    SwarmMesh = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("SwarmMesh"));
+    SwarmMesh->SetupAttachment(RootComponent);
+    SwarmMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    SwarmMesh->NumCustomDataFloats = 1;
+}
+
+void AFireflySwarm::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (!Analyzer)
+    {
+        Analyzer = FindComponentByClass<UMelOverbandAnalyzerComponent>();
+    }
+    if (!ForceFields)
+    {
+        ForceFields = FindComponentByClass<UForceFieldSetComponent>();
+    }
+
+    const bool bNiagara = RenderMode == EFireflySwarmRenderMode::Niagara;
+    SwarmSystem->SetVisibility(bNiagara);
+    SwarmMesh->SetVisibility(!bNiagara);
+    if (!bNiagara)
+    {
+        SwarmSystem->DeactivateImmediate();
+    }
+
+    ResetSwarm();
+}
+
+void AFireflySwarm::ResetSwarm()
+{
+    const int32 N = FMath::Max(1, NumFireflies);
+    FRandomStream Random(Seed);
+    const FVector3f Center(GetActorLocation());
+    const FVector3f Extent(SwarmExtent);
+
+    Position.SetNumUninitialized(N);
+    Velocity.SetNumUninitialized(N);
+    NextPosition.SetNumUninitialized(N);
+    NextVelocity.SetNumUninitialized(N);
+    Brightness.SetNumUninitialized(N);
+    Phase.SetNumUninitialized(N);
+    Band.SetNumUninitialized(N);
+
+    for (int32 i = 0; i < N; ++i)
+    {
+        Position[i] = Center + FVector3f(
+            Random.FRandRange(-Extent.X, Extent.X),
+            Random.FRandRange(-Extent.Y, Extent.Y),
+            Random.FRandRange(-Extent.Z, Extent.Z));
+        Velocity[i] = FVector3f(Random.GetUnitVector()) * (MaxSpeed * 0.5f);
+        Brightness[i] = BaseBrightness;
+        Phase[i] = Random.FRandRange(0.f, UE_TWO_PI);
+        // Reduced modulo the live band count, so any analyzer setup works.
+        Band[i] = uint16(Random.RandHelper(1024));
+    }
+
+    if (RenderMode == EFireflySwarmRenderMode::InstancedMesh)
+    {
+        UploadTransforms.SetNum(N);
+        for (int32 i = 0; i < N; ++i)
+        {
+            UploadTransforms[i] = FTransform(FQuat::Identity, FVector(Position[i]), FVector(InstanceScale));
+        }
+        SwarmMesh->ClearInstances();
+        SwarmMesh->AddInstances(UploadTransforms, false, true);
+    }
+
+    Time = 0.0f;
+    UE_LOG(LogFireflySwarm, Log, TEXT("%s: %d fireflies, seed %d."), *GetName(), N, Seed);
+}
+
+void AFireflySwarm::BuildGrid()
+{
+    const int32 N = Position.Num();
+    const int32 TableSize = int32(FMath::RoundUpToPowerOfTwo(uint32(FMath::Max(64, N * 2))));
+    HashMask = uint32(TableSize - 1);
+    InvCellSize = 1.0f / NeighborRadius;
+
+    // Counting sort by cell hash
+    CellStart.SetNumUninitialized(TableSize + 1);
+    FMemory::Memzero(CellStart.GetData(), CellStart.Num() * sizeof(int32));
+    CellHash.SetNumUninitialized(N);
+    SortedIndex.SetNumUninitialized(N);
+
+    for (int32 i = 0; i < N; ++i)
+    {
+        const uint32 H = HashCell(CellOf(Position[i]));
+        CellHash[i] = H;
+        ++CellStart[H];
+    }
+    for (int32 h = 1; h < TableSize; ++h)
+    {
+        CellStart[h] += CellStart[h - 1];
+    }
+    CellStart[TableSize] = N;
+    // Walking backwards turns each bucket end into its start.
+    for (int32 i = N - 1; i >= 0; --i)
+    {
+        SortedIndex[--CellStart[CellHash[i]]] = i;
+    }
+}
+
+void AFireflySwarm::SimulateRange(int32 Begin, int32 End, float DeltaTime, const FVector3f& Center, const TArray<float>& Bands, const TArray<FVector4>& Fields)
+{
+    const float RadiusSq = NeighborRadius * NeighborRadius;
+    const FVector3f Extent(SwarmExtent);
+    const int32 NumFields = Fields.Num() / 2;
+    const float BrightnessAlpha = FMath::Min(1.0f, BrightnessResponse * DeltaTime);
+    const float DragFactor = FMath::Max(0.0f, 1.0f - Drag * DeltaTime);
+
+    for (int32 i = Begin; i < End; ++i)
+    {
+        const FVector3f P = Position[i];
+        const FVector3f V = Velocity[i];
+        FVector3f Accel = FVector3f::ZeroVector;
+
+        // Flocking over the 27 surrounding cells; several cells can share a bucket.
+        FVector3f Separation = FVector3f::ZeroVector;
+        FVector3f VelocitySum = FVector3f::ZeroVector;
+        FVector3f PositionSum = FVector3f::ZeroVector;
+        int32 Neighbors = 0;
+
+        uint32 Visited[27];
+        int32 NumVisited = 0;
+        const FIntVector Cell = CellOf(P);
+        for (int32 dz = -1; dz <= 1 && Neighbors < MaxNeighbors; ++dz)
+        for (int32 dy = -1; dy <= 1 && Neighbors < MaxNeighbors; ++dy)
+        for (int32 dx = -1; dx <= 1 && Neighbors < MaxNeighbors; ++dx)
+        {
+            const uint32 H = HashCell(Cell + FIntVector(dx, dy, dz));
+            bool bSeen = false;
+            for (int32 v = 0; v < NumVisited && !bSeen; ++v)
+            {
+                bSeen = Visited[v] == H;
+            }
+            if (bSeen)
+            {
+                continue;
+            }
+            Visited[NumVisited++] = H;
+
+            for (int32 k = CellStart[H]; k < CellStart[H + 1] && Neighbors < MaxNeighbors; ++k)
+            {
+                const int32 j = SortedIndex[k];
+                const FVector3f Away = P - Position[j];
+                const float DistSq = Away.SizeSquared();
+                if (j == i || DistSq >= RadiusSq || DistSq < KINDA_SMALL_NUMBER)
+                {
+                    continue;
+                }
+                Separation += Away * (NeighborRadius / DistSq);
+                VelocitySum += Velocity[j];
+                PositionSum += Position[j];
+                ++Neighbors;
+            }
+        }
+        if (Neighbors > 0)
+        {
+            const float InvCount = 1.0f / Neighbors;
+            Accel += Separation * (SeparationWeight * MaxSpeed * InvCount);
+            Accel += (VelocitySum * InvCount - V) * AlignmentWeight;
+            Accel += (PositionSum * InvCount - P) * CohesionWeight;
+        }
+
+        // Force fields: [2f] = (position, radius), [2f + 1] = (strength, type)
+        for (int32 f = 0; f < NumFields; ++f)
+        {
+            const FVector4& A = Fields[2 * f];
+            const FVector4& B = Fields[2 * f + 1];
+            const FVector3f ToField = FVector3f(float(A.X), float(A.Y), float(A.Z)) - P;
+            const float Dist = ToField.Size();
+            const float Radius = float(A.W);
+            if (Dist >= Radius || Dist < KINDA_SMALL_NUMBER)
+            {
+                continue;
+            }
+            const float Falloff = 1.0f - Dist / Radius;
+            const float Strength = float(B.X) * Falloff;
+            const FVector3f Dir = ToField / Dist;
+            switch (EForceFieldType(int32(B.Y)))
+            {
+            case EForceFieldType::Attractor: Accel += Dir * (Strength * ForceFieldWeight); break;
+            case EForceFieldType::Repulsor:  Accel -= Dir * (Strength * ForceFieldWeight); break;
+            case EForceFieldType::Vortex:    Accel += FVector3f::CrossProduct(FVector3f::UpVector, Dir) * (Strength * ForceFieldWeight); break;
+            case EForceFieldType::Drag:      Accel -= V * Strength; break;
+            }
+        }
+
+        // Soft box around the actor
+        const FVector3f Local = P - Center;
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            const float Over = FMath::Abs(Local[Axis]) - Extent[Axis];
+            if (Over > 0.0f)
+            {
+                Accel[Axis] -= FMath::Sign(Local[Axis]) * Over * BoundsWeight;
+            }
+        }
+
+        // Cheap deterministic wander
+        const float Ph = Phase[i];
+        Accel += FVector3f(FMath::Sin(Time * 0.7f + Ph), FMath::Cos(Time * 0.5f + Ph * 1.3f), 0.5f * FMath::Sin(Time * 0.3f + Ph * 2.1f)) * WanderStrength;
+
+        // Audio response
+        const float Level = Bands.Num() > 0 ? Bands[Band[i] % Bands.Num()] : 0.0f;
+        Brightness[i] += (BaseBrightness + Level * AudioBrightnessGain - Brightness[i]) * BrightnessAlpha;
+        const float SpeedLimit = MaxSpeed * (1.0f + AudioSpeedGain * Level);
+
+        FVector3f NewV = (V + Accel * DeltaTime) * DragFactor;
+        const float SpeedSq = NewV.SizeSquared();
+        if (SpeedSq > SpeedLimit * SpeedLimit)
+        {
+            NewV *= SpeedLimit * FMath::InvSqrt(SpeedSq);
+        }
+        NextVelocity[i] = NewV;
+        NextPosition[i] = P + NewV * DeltaTime;
+    }
+}
+
+void AFireflySwarm::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    const int32 N = Position.Num();
+    if (N == 0)
+    {
+        return;
+    }
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    // Large hitches would make the integration explode.
+    DeltaTime = FMath::Min(DeltaTime, 1.0f / 30.0f);
+    Time += DeltaTime;
+
+    static const TArray<float> NoBands;
+    static const TArray<FVector4> NoFields;
+    const TArray<float>& Bands = Analyzer ? Analyzer->GetLastOutput() : NoBands;
+    const TArray<FVector4>& Fields = ForceFields ? ForceFields->GetPackedFields() : NoFields;
+    const FVector3f Center(GetActorLocation());
+
+    BuildGrid();
+
+    const int32 Chunk = FMath::Max(16, ChunkSize);
+    const int32 NumChunks = FMath::DivideAndRoundUp(N, Chunk);
+    ParallelFor(NumChunks, [&](int32 ChunkIndex)
+        {
+            const int32 Begin = ChunkIndex * Chunk;
+            SimulateRange(Begin, FMath::Min(N, Begin + Chunk), DeltaTime, Center, Bands, Fields);
+        });
+
+    Swap(Position, NextPosition);
+    Swap(Velocity, NextVelocity);
+
+    Upload();
+
+    LastUpdateMs = float(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+}
+
+void AFireflySwarm::Upload()
+{
+    const int32 N = Position.Num();
+
+    if (RenderMode == EFireflySwarmRenderMode::Niagara)
+    {
+        UploadPositions.SetNumUninitialized(N, false);
+        for (int32 i = 0; i < N; ++i)
+        {
+            UploadPositions[i] = FVector(Position[i]);
+        }
+        UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector(SwarmSystem, PositionsParameter, UploadPositions);
+        UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayFloat(SwarmSystem, BrightnessParameter, Brightness);
+        SwarmSystem->SetVariableInt(CountParameter, N);
+        return;
+    }
+
+    UploadTransforms.SetNum(N, false);
+    const FVector Scale(InstanceScale);
+    for (int32 i = 0; i < N; ++i)
+    {
+        UploadTransforms[i] = FTransform(FQuat::Identity, FVector(Position[i]), Scale);
+        SwarmMesh->SetCustomDataValue(i, 0, Brightness[i], false);
+    }
+    SwarmMesh->BatchUpdateInstancesTransforms(0, UploadTransforms, true, true, true);
+}
@@ -0,0 +1,230 @@
+// ForceFieldSetComponent.cpp
+
+#include "ForceFieldSetComponent.h"
+#include "NiagaraComponent.h"
+#include "NiagaraDataInterfaceArrayFunctionLibrary.h"
+#include "NiagaraTargetRegistrySubsystem.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogForceFieldSet, Log, All);
+
+UForceFieldSetComponent::UForceFieldSetComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    // After pawn movement and motion controller updates.
+    PrimaryComponentTick.TickGroup = TG_PostPhysics;
+
+    // What the fixed Sim_LeftHand/RightHand/Pawn scalars used to describe.
+    FForceFieldSource LeftHand;
+    LeftHand.Name = TEXT("LeftHand");
+    LeftHand.ComponentTag = TEXT("LeftHand");
+    ForceFields.Add(LeftHand);
+
+    FForceFieldSource RightHand;
+    RightHand.Name = TEXT("RightHand");
+    RightHand.ComponentTag = TEXT("RightHand");
+    ForceFields.Add(RightHand);
+
+    FForceFieldSource Pawn;
+    Pawn.Name = TEXT("Pawn");
+    Pawn.Radius = 200.0f;
+    ForceFields.Add(Pawn);
+}
+
+void UForceFieldSetComponent::BeginPlay()
+{
+    Super::BeginPlay();
+    for (FForceFieldSource& Field : ForceFields)
+    {
+        ResolveFollowed(Field);
+    }
+    bTargetsDirty = true;
+}
+
+void UForceFieldSetComponent::ResolveFollowed(FForceFieldSource& Field) const
+{
+    Field.Followed = nullptr;
+    if (Field.bFixedLocation)
+    {
+        return;
+    }
+
+    const AActor* Source = Field.SourceActor ? Field.SourceActor.Get() : GetOwner();
+    if (Source)
+    {
+        Field.Followed = Field.ComponentTag.IsNone()
+            ? Source->GetRootComponent()
+            : Cast<USceneComponent>(Source->FindComponentByTag(USceneComponent::StaticClass(), Field.ComponentTag));
+    }
+    if (!Field.Followed.IsValid())
+    {
+        UE_LOG(LogForceFieldSet, Warning, TEXT("%s: force field %s has nothing to follow (tag %s on %s)."),
+            *GetNameSafe(GetOwner()), *Field.Name.ToString(), *Field.ComponentTag.ToString(), *GetNameSafe(Source));
+    }
+}
+
+FForceFieldSource* UForceFieldSetComponent::FindField(FName Name)
+{
+    return ForceFields.FindByPredicate([Name](const FForceFieldSource& Field) { return Field.Name == Name; });
+}
+
+void UForceFieldSetComponent::AddForceField(const FForceFieldSource& Field)
+{
+    FForceFieldSource* Existing = Field.Name.IsNone() ? nullptr : FindField(Field.Name);
+    FForceFieldSource& Slot = Existing ? *Existing : ForceFields.AddDefaulted_GetRef();
+    Slot = Field;
+    if (HasBegunPlay())
+    {
+        ResolveFollowed(Slot);
+    }
+}
+
+bool UForceFieldSetComponent::RemoveForceField(FName Name)
+{
+    return ForceFields.RemoveAll([Name](const FForceFieldSource& Field) { return Field.Name == Name; }) > 0;
+}
+
+bool UForceFieldSetComponent::SetForceFieldEnabled(FName Name, bool bEnabled)
+{
+    FForceFieldSource* Field = FindField(Name);
+    if (Field)
+    {
+        Field->bEnabled = bEnabled;
+    }
+    return Field != nullptr;
+}
+
+bool UForceFieldSetComponent::SetForceFieldStrength(FName Name, float Strength, float Radius)
+{
+    FForceFieldSource* Field = FindField(Name);
+    if (Field)
+    {
+        Field->Strength = Strength;
+        if (Radius >= 0.0f)
+        {
+            Field->Radius = Radius;
+        }
+    }
+    return Field != nullptr;
+}
+
+void UForceFieldSetComponent::GatherTargets()
+{
+    Targets.Reset();
+    for (UNiagaraComponent* Component : TargetComponents)
+    {
+        if (IsValid(Component))
+        {
+            Targets.AddUnique(Component);
+        }
+    }
+
+    if (UNiagaraTargetRegistrySubsystem* Registry = UNiagaraTargetRegistrySubsystem::Get(this))
+    {
+        TArray<UNiagaraComponent*> Found;
+        for (const FString& Sub : TargetActorNameSubstrings)
+        {
+            Registry->FindNiagaraComponentsByActorName(Sub, Found);
+            for (UNiagaraComponent* Component : Found)
+            {
+                Targets.AddUnique(Component);
+            }
+        }
+        TargetRevision = Registry->GetRevision();
+    }
+    bTargetsDirty = false;
+}
+
+void UForceFieldSetComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    const UNiagaraTargetRegistrySubsystem* Registry = UNiagaraTargetRegistrySubsystem::Get(this);
+    const bool bNewTargets = bTargetsDirty || (Registry && Registry->GetRevision() != TargetRevision);
+    if (bNewTargets)
+    {
+        GatherTargets();
+    }
+
+    FBox Bounds(ForceInit);
+    for (const TWeakObjectPtr<UNiagaraComponent>& Target : Targets)
+    {
+        if (const UNiagaraComponent* Component = Target.Get())
+        {
+            Bounds += Component->Bounds.GetBox();
+        }
+    }
+    const bool bCull = CullMargin >= 0.0f && Bounds.IsValid;
+
+    // Place and cull
+    Positions.SetNumUninitialized(ForceFields.Num(), false);
+    Candidates.Reset();
+    for (int32 i = 0; i < ForceFields.Num(); ++i)
+    {
+        const FForceFieldSource& Field = ForceFields[i];
+        if (!Field.bEnabled)
+        {
+            continue;
+        }
+
+        if (Field.bFixedLocation)
+        {
+            Positions[i] = Field.Offset;
+        }
+        else if (const USceneComponent* Followed = Field.Followed.Get())
+        {
+            Positions[i] = Followed->GetComponentTransform().TransformPosition(Field.Offset);
+        }
+        else
+        {
+            continue;
+        }
+
+        const float DistSq = bCull ? Bounds.ComputeSquaredDistanceToPoint(Positions[i]) : 0.0f;
+        const float Reach = Field.Radius + CullMargin;
+        if (bCull && DistSq > Reach * Reach)
+        {
+            continue;
+        }
+        Candidates.Emplace(DistSq, i);
+    }
+
+    // Cap, keeping the fields nearest to the systems (index breaks ties)
+    if (Candidates.Num() > MaxForceFields)
+    {
+        Candidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B)
+            {
+                return A.Key < B.Key || (A.Key == B.Key && A.Value < B.Value);
+            });
+        Candidates.SetNum(MaxForceFields, false);
+    }
+
+    Packed.Reset(Candidates.Num() * 2);
+    for (const TPair<float, int32>& Candidate : Candidates)
+    {
+        const FForceFieldSource& Field = ForceFields[Candidate.Value];
+        Packed.Emplace(Positions[Candidate.Value], Field.Radius);
+        Packed.Emplace(Field.Strength, float(Field.Type), 0.0f, 0.0f);
+    }
+    ActiveCount = Candidates.Num();
+
+    // Nothing moved: skip the upload
+    if (!bNewTargets && Packed == UploadedPacked)
+    {
+        return;
+    }
+
+    for (const TWeakObjectPtr<UNiagaraComponent>& Target : Targets)
+    {
+        if (UNiagaraComponent* Component = Target.Get())
+        {
+            UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector4(Component, ArrayParameter, Packed);
+            if (!CountParameter.IsNone())
+            {
+                Component->SetVariableInt(CountParameter, ActiveCount);
+            }
+        }
+    }
+    UploadedPacked = Packed;
+}
@@ -0,0 +1,208 @@
+// FrameBudgetGovernorComponent.cpp
+
+#include "FrameBudgetGovernorComponent.h"
+#include "NiagaraComponent.h"
+#include "RenderCore.h"
+#include "RHI.h"
+#include "DynamicRHI.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFrameBudget, Log, All);
+
+UFrameBudgetGovernorComponent::UFrameBudgetGovernorComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = true;
+    PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void UFrameBudgetGovernorComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    const FString Dir = FPaths::ProjectSavedDir() + TEXT("StudyResults/FrameBudget/");
+    IFileManager::Get().MakeDirectory(*Dir, true);
+    LogPath = Dir + FString::Printf(TEXT("FrameBudget_%s.csv"), *FDateTime::UtcNow().ToString(TEXT("%Y%m%d_%H%M%S")));
+
+    // Bring everything registered in the editor to the start factor and record it.
+    const float Start = Factor;
+    Factor = -1.f;
+    SetFactor(Start, TEXT("Initial"));
+}
+
+void UFrameBudgetGovernorComponent::RegisterNiagaraSystem(const FGovernedNiagaraSystem& System)
+{
+    if (!System.Component)
+    {
+        return;
+    }
+    FGovernedNiagaraSystem* Existing = NiagaraSystems.FindByPredicate([&System](const FGovernedNiagaraSystem& S) { return S.Component == System.Component; });
+    FGovernedNiagaraSystem& Slot = Existing ? *Existing : NiagaraSystems.Add_GetRef(System);
+    Slot = System;
+    ApplyToNiagara(Slot);
+}
+
+void UFrameBudgetGovernorComponent::RegisterActor(AActor* Actor, float BaseTickInterval, float MaxTickInterval)
+{
+    if (!Actor)
+    {
+        return;
+    }
+    FGovernedActor* Existing = Actors.FindByPredicate([Actor](const FGovernedActor& G) { return G.Actor == Actor; });
+    FGovernedActor& Slot = Existing ? *Existing : Actors.AddDefaulted_GetRef();
+    Slot.Actor = Actor;
+    Slot.BaseTickInterval = BaseTickInterval;
+    Slot.MaxTickInterval = MaxTickInterval;
+    ApplyToActor(Slot);
+}
+
+void UFrameBudgetGovernorComponent::UnregisterActor(AActor* Actor)
+{
+    for (int32 i = Actors.Num() - 1; i >= 0; --i)
+    {
+        if (Actors[i].Actor == Actor)
+        {
+            if (IsValid(Actor))
+            {
+                Actor->SetActorTickInterval(Actors[i].BaseTickInterval);
+            }
+            Actors.RemoveAtSwap(i);
+        }
+    }
+}
+
+void UFrameBudgetGovernorComponent::GetFrameTimes(float& OutGameMs, float& OutRenderMs, float& OutGpuMs) const
+{
+    OutGameMs = GameMs;
+    OutRenderMs = RenderMs;
+    OutGpuMs = GpuMs;
+}
+
+void UFrameBudgetGovernorComponent::ApplyToNiagara(const FGovernedNiagaraSystem& System) const
+{
+    UNiagaraComponent* Component = System.Component;
+    if (!IsValid(Component))
+    {
+        return;
+    }
+    if (!System.SpawnRateParameter.IsNone())
+    {
+        Component->SetVariableFloat(System.SpawnRateParameter, System.BaseSpawnRate * Factor);
+    }
+    if (!System.MaxParticlesParameter.IsNone())
+    {
+        Component->SetVariableInt(System.MaxParticlesParameter, FMath::Max(1, FMath::RoundToInt(System.BaseMaxParticles * Factor)));
+    }
+    if (!System.FactorParameter.IsNone())
+    {
+        Component->SetVariableFloat(System.FactorParameter, Factor);
+    }
+}
+
+void UFrameBudgetGovernorComponent::ApplyToActor(const FGovernedActor& Governed) const
+{
+    AActor* Actor = Governed.Actor;
+    if (!IsValid(Actor))
+    {
+        return;
+    }
+    // 1 -> base interval, MinFactor -> max interval
+    const float Alpha = MinFactor < 1.f ? FMath::Clamp((1.f - Factor) / (1.f - MinFactor), 0.f, 1.f) : 0.f;
+    Actor->SetActorTickInterval(FMath::Lerp(Governed.BaseTickInterval, Governed.MaxTickInterval, Alpha));
+}
+
+void UFrameBudgetGovernorComponent::SetFactor(float InFactor, const FString& Reason)
+{
+    InFactor = FMath::Clamp(InFactor, MinFactor, 1.f);
+    if (FMath::IsNearlyEqual(InFactor, Factor))
+    {
+        return;
+    }
+
+    const float FromFactor = Factor;
+    Factor = InFactor;
+    OverBudgetSeconds = 0.f;
+    UnderBudgetSeconds = 0.f;
+
+    NiagaraSystems.RemoveAllSwap([](const FGovernedNiagaraSystem& S) { return !IsValid(S.Component); });
+    Actors.RemoveAllSwap([](const FGovernedActor& G) { return !IsValid(G.Actor); });
+    for (const FGovernedNiagaraSystem& System : NiagaraSystems)
+    {
+        ApplyToNiagara(System);
+    }
+    for (const FGovernedActor& Governed : Actors)
+    {
+        ApplyToActor(Governed);
+    }
+
+    UE_LOG(LogFrameBudget, Log, TEXT("Scalability %.3f -> %.3f (%s): game %.2f ms, render %.2f ms, gpu %.2f ms"),
+        FromFactor, Factor, *Reason, GameMs, RenderMs, GpuMs);
+    if (bLogChanges)
+    {
+        AppendLog(FromFactor, Reason);
+    }
+
+    OnScalabilityFactorChanged.Broadcast(Factor, Reason);
+}
+
+void UFrameBudgetGovernorComponent::AppendLog(float FromFactor, const FString& Reason)
+{
+    if (LogPath.IsEmpty())
+    {
+        return;
+    }
+
+    FString Lines;
+    if (!IFileManager::Get().FileExists(*LogPath))
+    {
+        Lines = TEXT("UtcTime,WorldSeconds,FromFactor,ToFactor,GameMs,RenderMs,GpuMs,BudgetMs,NiagaraSystems,Actors,Reason\n");
+    }
+
+    const UWorld* World = GetWorld();
+    Lines += FString::Printf(TEXT("%s,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%d,%d,%s\n"),
+        *FDateTime::UtcNow().ToIso8601(),
+        World ? World->GetTimeSeconds() : 0.f,
+        FromFactor, Factor, GameMs, RenderMs, GpuMs, BudgetMs,
+        NiagaraSystems.Num(), Actors.Num(), *Reason);
+
+    FFileHelper::SaveStringToFile(Lines, *LogPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+}
+
+void UFrameBudgetGovernorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    // Last completed frame, in cycles; GPU reads 0 where the RHI has no timing.
+    const float Game = float(FPlatformTime::ToMilliseconds(GGameThreadTime));
+    const float Render = float(FPlatformTime::ToMilliseconds(GRenderThreadTime));
+    const float Gpu = float(FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles()));
+    GameMs = FMath::Lerp(Game, GameMs, TimeSmoothing);
+    RenderMs = FMath::Lerp(Render, RenderMs, TimeSmoothing);
+    GpuMs = FMath::Lerp(Gpu, GpuMs, TimeSmoothing);
+
+    if (bFrozen)
+    {
+        OverBudgetSeconds = 0.f;
+        UnderBudgetSeconds = 0.f;
+        return;
+    }
+
+    const float SlowestMs = FMath::Max3(GameMs, RenderMs, GpuMs);
+    OverBudgetSeconds = SlowestMs > BudgetMs ? OverBudgetSeconds + DeltaTime : 0.f;
+    UnderBudgetSeconds = SlowestMs < BudgetMs * StepUpFraction ? UnderBudgetSeconds + DeltaTime : 0.f;
+
+    if (OverBudgetSeconds > StepDownHoldSeconds && Factor > MinFactor)
+    {
+        const TCHAR* Bottleneck = SlowestMs == GpuMs ? TEXT("OverBudgetGPU") : SlowestMs == RenderMs ? TEXT("OverBudgetRender") : TEXT("OverBudgetGame");
+        SetFactor(Factor - StepSize, Bottleneck);
+    }
+    else if (UnderBudgetSeconds > StepUpHoldSeconds && Factor < 1.f)
+    {
+        SetFactor(Factor + StepSize, TEXT("UnderBudget"));
+    }
+}
@@ -0,0 +1,79 @@
+// HarmonicPercussiveComponent.cpp
+
+#include "HarmonicPercussiveComponent.h"
+#include "HAL/PlatformTime.h"
+
+UHarmonicPercussiveComponent::UHarmonicPercussiveComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UHarmonicPercussiveComponent::SetAnalyzer(UAudioAnalysisToolsLibrary* InAnalyzer, int32 InFrameSize, float InSampleRate)
+{
+    check(InAnalyzer);
+    AATools = InAnalyzer;
+    BinHz = InSampleRate / FMath::Max(1, InFrameSize);
+
+    // Bin count is taken from the first spectrum, since the plugin may return N/2 or N/2+1.
+    Separator = FHarmonicPercussiveSeparator();
+}
+
+void UHarmonicPercussiveComponent::Process()
+{
+    if (!bProcessingEnabled)
+    {
+        LastProcessMs = 0.f;
+        return;
+    }
+
+    check(AATools);
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    const TArray<float>& Mag = AATools->GetMagnitudeSpectrum();
+
+    if (Mag.Num() != Separator.GetNumBins())
+    {
+        Separator.Init(Mag.Num(), HarmonicWindowFrames, PercussiveWindowBins, MaskPower, BinHz);
+    }
+    Separator.Process(Mag.GetData());
+    LastProcessMs = float(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+}
+
+FSpectralShapeFeatures UHarmonicPercussiveComponent::GetSpectralShape(EOverbandSpectrumSource Source) const
+{
+    FSpectralShapeFeatures Features;
+    if (Source == EOverbandSpectrumSource::Mixed && !AATools)
+    {
+        return Features;
+    }
+    const TArray<float>& Mag = (Source == EOverbandSpectrumSource::Mixed) ? AATools->GetMagnitudeSpectrum()
+        : (Source == EOverbandSpectrumSource::Harmonic) ? Separator.GetHarmonicSpectrum()
+        : Separator.GetPercussiveSpectrum();
+    if (Mag.Num() == 0)
+    {
+        return Features;
+    }
+
+    float Sum = 0.f, Weighted = 0.f, Peak = 0.f, LogSum = 0.f;
+    for (int32 k = 0; k < Mag.Num(); ++k)
+    {
+        Sum += Mag[k];
+        Weighted += Mag[k] * k;
+        Peak = FMath::Max(Peak, Mag[k]);
+        LogSum += FMath::Loge(Mag[k] + SMALL_NUMBER);
+    }
+    if (Sum <= SMALL_NUMBER)
+    {
+        return Features;
+    }
+
+    const float Mean = Sum / Mag.Num();
+    Features.CentroidHz = BinHz * Weighted / Sum;
+    Features.Crest = Peak / Mean;
+    Features.Flatness = FMath::Exp(LogSum / Mag.Num()) / Mean;
+    return Features;
+}
+
+void UHarmonicPercussiveComponent::ResetSeparation()
+{
+    Separator.Reset();
+}
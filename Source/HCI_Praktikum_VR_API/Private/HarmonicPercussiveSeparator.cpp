@@ -0,0 +1,86 @@
+// HarmonicPercussiveSeparator.cpp
+
+#include "HarmonicPercussiveSeparator.h"
+
+void FHarmonicPercussiveSeparator::Init(int32 InNumBins, int32 InHarmonicWindow, int32 InPercussiveWindow, float InMaskPower, float InBinHz)
+{
+    NumBins = FMath::Max(0, InNumBins);
+    MaskPower = FMath::Max(InMaskPower, 0.1f);
+    BinHz = InBinHz;
+
+    TimeMedians.Init(NumBins, InHarmonicWindow);
+    FreqMedian.Init(1, InPercussiveWindow);
+    PercussiveHalf = FreqMedian.GetWindowSize() / 2;
+
+    HarmonicEstimate.SetNumUninitialized(NumBins);
+    PercussiveEstimate.SetNumUninitialized(NumBins);
+    Reset();
+}
+
+void FHarmonicPercussiveSeparator::Reset()
+{
+    TimeMedians.Reset();
+    Harmonic.Init(0.f, NumBins);
+    Percussive.Init(0.f, NumBins);
+    HarmonicMask.Init(0.5f, NumBins);
+    PercussiveMask.Init(0.5f, NumBins);
+    HarmonicEnergy = PercussiveEnergy = PercussiveFlux = HarmonicCentroidHz = 0.f;
+}
+
+void FHarmonicPercussiveSeparator::Process(const float* Magnitudes)
+{
+    if (NumBins == 0)
+    {
+        return;
+    }
+
+    // Harmonic estimate: median of each bin across time.
+    TimeMedians.PushAll(Magnitudes, HarmonicEstimate.GetData());
+
+    // Percussive estimate: centred median across frequency, zero-padded at the
+    // edges. Output for bin k is ready once bin k + Half has been pushed.
+    FreqMedian.ResetChannel(0);
+    for (int32 j = 0; j < NumBins + PercussiveHalf; ++j)
+    {
+        const float Median = FreqMedian.Push(0, j < NumBins ? Magnitudes[j] : 0.f);
+        const int32 k = j - PercussiveHalf;
+        if (k >= 0)
+        {
+            PercussiveEstimate[k] = Median;
+        }
+    }
+
+    // Soft Wiener masks and features in one pass.
+    const bool bSquare = FMath::IsNearlyEqual(MaskPower, 2.f);
+    float HSum = 0.f, PSum = 0.f, Flux = 0.f, CentroidNum = 0.f, CentroidDen = 0.f;
+    for (int32 k = 0; k < NumBins; ++k)
+    {
+        const float HE = HarmonicEstimate[k];
+        const float PE = PercussiveEstimate[k];
+        const float HP = bSquare ? HE * HE : FMath::Pow(HE, MaskPower);
+        const float PP = bSquare ? PE * PE : FMath::Pow(PE, MaskPower);
+        const float Den = HP + PP;
+        const float MaskH = (Den > SMALL_NUMBER) ? HP / Den : 0.5f;
+
+        const float Mag = Magnitudes[k];
+        const float H = Mag * MaskH;
+        const float P = Mag - H;
+
+        Flux += FMath::Max(0.f, P - Percussive[k]);
+        HSum += H * H;
+        PSum += P * P;
+        CentroidNum += H * k;
+        CentroidDen += H;
+
+        HarmonicMask[k] = MaskH;
+        PercussiveMask[k] = 1.f - MaskH;
+        Harmonic[k] = H;
+        Percussive[k] = P;
+    }
+
+    const float InvBins = 1.f / NumBins;
+    HarmonicEnergy = HSum * InvBins;
+    PercussiveEnergy = PSum * InvBins;
+    PercussiveFlux = Flux * InvBins;
+    HarmonicCentroidHz = (CentroidDen > SMALL_NUMBER) ? BinHz * CentroidNum / CentroidDen : 0.f;
+}
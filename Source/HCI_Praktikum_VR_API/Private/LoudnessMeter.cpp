@@ -0,0 +1,214 @@
+// LoudnessMeter.cpp
+
+#include "LoudnessMeter.h"
+#include "Math/UnrealMathUtility.h"
+
+namespace LoudnessMeter
+{
+    /** Mean-square energy at each histogram bin centre, computed once. */
+    template <int32 NumBins>
+    static const double* GetBinEnergies(float MinLufs, float StepLu)
+    {
+        static const TArray<double> Table = [MinLufs, StepLu]()
+            {
+                TArray<double> Out;
+                Out.SetNumUninitialized(NumBins);
+                for (int32 Bin = 0; Bin < NumBins; ++Bin)
+                {
+                    Out[Bin] = FMath::Pow(10.0, (double(MinLufs + (Bin + 0.5f) * StepLu) + 0.691) / 10.0);
+                }
+                return Out;
+            }();
+        return Table.GetData();
+    }
+}
+
+FLoudnessMeter::FBiquadCoefs FLoudnessMeter::MakeCoefs(double B0, double B1, double B2, double A1, double A2)
+{
+    FBiquadCoefs C;
+    C.B0 = VectorSetFloat1(float(B0));
+    C.B1 = VectorSetFloat1(float(B1));
+    C.B2 = VectorSetFloat1(float(B2));
+    C.A1 = VectorSetFloat1(float(A1));
+    C.A2 = VectorSetFloat1(float(A2));
+    return C;
+}
+
+void FLoudnessMeter::Init(float InSampleRate, int32 InNumChannels)
+{
+    SampleRate = InSampleRate;
+    NumChannels = FMath::Clamp(InNumChannels, 1, MaxChannels);
+    SubBlockLength = FMath::Max(1, FMath::RoundToInt(SampleRate * 0.1f));
+
+    // BS.1770 stage 1 (high shelf) and stage 2 (RLB high-pass), re-derived for the
+    // actual sample rate so 44.1 kHz (Android) and 48 kHz (PC) both match the spec.
+    {
+        const double F0 = 1681.974450955533;
+        const double G = 3.999843853973347;
+        const double Q = 0.7071752369554196;
+        const double K = FMath::Tan(PI * F0 / SampleRate);
+        const double Vh = FMath::Pow(10.0, G / 20.0);
+        const double Vb = FMath::Pow(Vh, 0.4996667741545416);
+        const double A0 = 1.0 + K / Q + K * K;
+        Shelf = MakeCoefs(
+            (Vh + Vb * K / Q + K * K) / A0,
+            2.0 * (K * K - Vh) / A0,
+            (Vh - Vb * K / Q + K * K) / A0,
+            2.0 * (K * K - 1.0) / A0,
+            (1.0 - K / Q + K * K) / A0);
+    }
+    {
+        const double F0 = 38.13547087602444;
+        const double Q = 0.5003270373238773;
+        const double K = FMath::Tan(PI * F0 / SampleRate);
+        const double A0 = 1.0 + K / Q + K * K;
+        HighPass = MakeCoefs(
+            1.0, -2.0, 1.0,
+            2.0 * (K * K - 1.0) / A0,
+            (1.0 - K / Q + K * K) / A0);
+    }
+
+    Reset();
+}
+
+void FLoudnessMeter::Reset()
+{
+    ShelfZ1 = ShelfZ2 = HighPassZ1 = HighPassZ2 = VectorZeroFloat();
+    SubBlockSum = VectorZeroFloat();
+    SubBlockFill = 0;
+    FMemory::Memzero(SubBlockEnergy, sizeof(SubBlockEnergy));
+    SubBlockHead = 0;
+    SubBlocksSeen = 0;
+    MomentaryLufs = SilenceLufs;
+    ShortTermLufs = SilenceLufs;
+    FMemory::Memzero(HistogramCounts, sizeof(HistogramCounts));
+}
+
+void FLoudnessMeter::Process(const float* Interleaved, int32 NumFrames)
+{
+    if (!IsInitialized() || !Interleaved)
+    {
+        return;
+    }
+
+    // Keep the filter state in registers for the whole call.
+    VectorRegister4Float S1 = ShelfZ1, S2 = ShelfZ2, H1 = HighPassZ1, H2 = HighPassZ2;
+    VectorRegister4Float Sum = SubBlockSum;
+    float Lanes[MaxChannels] = { 0.f, 0.f, 0.f, 0.f };
+
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        const float* In = Interleaved + Frame * NumChannels;
+        for (int32 Ch = 0; Ch < NumChannels; ++Ch)
+        {
+            Lanes[Ch] = In[Ch];
+        }
+        const VectorRegister4Float X = VectorLoad(Lanes);
+
+        // Transposed direct form II, stage 1.
+        const VectorRegister4Float Y1 = VectorMultiplyAdd(Shelf.B0, X, S1);
+        S1 = VectorSubtract(VectorMultiplyAdd(Shelf.B1, X, S2), VectorMultiply(Shelf.A1, Y1));
+        S2 = VectorSubtract(VectorMultiply(Shelf.B2, X), VectorMultiply(Shelf.A2, Y1));
+
+        // Stage 2.
+        const VectorRegister4Float Y2 = VectorMultiplyAdd(HighPass.B0, Y1, H1);
+        H1 = VectorSubtract(VectorMultiplyAdd(HighPass.B1, Y1, H2), VectorMultiply(HighPass.A1, Y2));
+        H2 = VectorSubtract(VectorMultiply(HighPass.B2, Y1), VectorMultiply(HighPass.A2, Y2));
+
+        Sum = VectorMultiplyAdd(Y2, Y2, Sum);
+
+        if (++SubBlockFill == SubBlockLength)
+        {
+            SubBlockSum = Sum;
+            FinishSubBlock();
+            Sum = VectorZeroFloat();
+        }
+    }
+
+    ShelfZ1 = S1; ShelfZ2 = S2; HighPassZ1 = H1; HighPassZ2 = H2;
+    SubBlockSum = Sum;
+}
+
+void FLoudnessMeter::FinishSubBlock()
+{
+    // Channel weights are 1.0 for L/R/C; surround channels are not used in this project.
+    float PerChannel[MaxChannels];
+    VectorStore(SubBlockSum, PerChannel);
+    float Energy = 0.f;
+    for (int32 Ch = 0; Ch < NumChannels; ++Ch)
+    {
+        Energy += PerChannel[Ch];
+    }
+    Energy /= float(SubBlockLength);
+
+    SubBlockEnergy[SubBlockHead] = Energy;
+    SubBlockHead = (SubBlockHead + 1) % SubBlocksShortTerm;
+    SubBlocksSeen = FMath::Min(SubBlocksSeen + 1, SubBlocksShortTerm);
+    SubBlockFill = 0;
+
+    // Sliding windows over the sub-block ring; at most 30 adds per 100 ms.
+    double Momentary = 0.0, ShortTerm = 0.0;
+    for (int32 i = 0; i < SubBlocksSeen; ++i)
+    {
+        const int32 Idx = (SubBlockHead - 1 - i + SubBlocksShortTerm) % SubBlocksShortTerm;
+        if (i < SubBlocksMomentary)
+        {
+            Momentary += SubBlockEnergy[Idx];
+        }
+        ShortTerm += SubBlockEnergy[Idx];
+    }
+
+    if (SubBlocksSeen >= SubBlocksMomentary)
+    {
+        MomentaryLufs = EnergyToLufs(Momentary / SubBlocksMomentary);
+
+        // Gating blocks are the 400 ms momentary windows with 75 % overlap.
+        if (MomentaryLufs >= HistogramMinLufs)
+        {
+            const int32 Bin = FMath::Clamp(int32((MomentaryLufs - HistogramMinLufs) / HistogramStepLu), 0, HistogramBins - 1);
+            ++HistogramCounts[Bin];
+        }
+    }
+    ShortTermLufs = EnergyToLufs(ShortTerm / FMath::Max(1, SubBlocksSeen));
+}
+
+float FLoudnessMeter::GetIntegratedLufs() const
+{
+    const double* BinEnergy = LoudnessMeter::GetBinEnergies<HistogramBins>(HistogramMinLufs, HistogramStepLu);
+
+    // Absolute gate is implicit: only blocks above -70 LUFS were binned.
+    double EnergySum = 0.0;
+    uint64 Count = 0;
+    for (int32 Bin = 0; Bin < HistogramBins; ++Bin)
+    {
+        if (HistogramCounts[Bin])
+        {
+            EnergySum += HistogramCounts[Bin] * BinEnergy[Bin];
+            Count += HistogramCounts[Bin];
+        }
+    }
+    if (Count == 0)
+    {
+        return SilenceLufs;
+    }
+
+    const float RelativeGate = EnergyToLufs(EnergySum / double(Count)) - 10.0f;
+    const int32 FirstBin = FMath::Clamp(int32((RelativeGate - HistogramMinLufs) / HistogramStepLu), 0, HistogramBins - 1);
+
+    EnergySum = 0.0;
+    Count = 0;
+    for (int32 Bin = FirstBin; Bin < HistogramBins; ++Bin)
+    {
+        if (HistogramCounts[Bin])
+        {
+            EnergySum += HistogramCounts[Bin] * BinEnergy[Bin];
+            Count += HistogramCounts[Bin];
+        }
+    }
+    return Count ? EnergyToLufs(EnergySum / double(Count)) : SilenceLufs;
+}
+
+float FLoudnessMeter::EnergyToLufs(double Energy)
+{
+    return Energy > 1e-12 ? float(-0.691 + 10.0 * FMath::LogX(10.0, Energy)) : SilenceLufs;
+}
@@ -0,0 +1,62 @@
+// LoudnessMeterComponent.cpp
+
+#include "LoudnessMeterComponent.h"
+#include "Components/AudioComponent.h"
+
+ULoudnessMeterComponent::ULoudnessMeterComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void ULoudnessMeterComponent::BeginPlay()
+{
+    Super::BeginPlay();
+    Configure(SampleRate, NumChannels);
+}
+
+void ULoudnessMeterComponent::Configure(float InSampleRate, int32 InNumChannels)
+{
+    SampleRate = InSampleRate;
+    NumChannels = FMath::Clamp(InNumChannels, 1, FLoudnessMeter::MaxChannels);
+    Meter.Init(SampleRate, NumChannels);
+    NormalizationDb = 0.f;
+}
+
+void ULoudnessMeterComponent::ResetMeter()
+{
+    Meter.Reset();
+    NormalizationDb = 0.f;
+}
+
+void ULoudnessMeterComponent::ProcessAudioFrames(const TArray<float>& AudioFrames)
+{
+    // The properties are Blueprint-writable; a changed format takes effect here, with fresh history.
+    if (!Meter.IsInitialized() || Meter.GetNumChannels() != NumChannels || Meter.GetSampleRate() != SampleRate)
+    {
+        Configure(SampleRate, NumChannels);
+    }
+
+    const int32 NumFrames = AudioFrames.Num() / Meter.GetNumChannels();
+    Meter.Process(AudioFrames.GetData(), NumFrames);
+
+    // Slew-limited gain towards the target, driven by short-term loudness so
+    // single transients do not pump the volume.
+    const float ShortTerm = Meter.GetShortTermLufs();
+    if (ShortTerm > FLoudnessMeter::SilenceLufs)
+    {
+        const float Desired = FMath::Clamp(TargetLufs - ShortTerm, -MaxNormalizationDb, MaxNormalizationDb);
+        const float MaxStep = NormalizationSlewDbPerSecond * NumFrames / Meter.GetSampleRate();
+        NormalizationDb += FMath::Clamp(Desired - NormalizationDb, -MaxStep, MaxStep);
+    }
+
+    if (NormalizationTarget)
+    {
+        NormalizationTarget->SetVolumeMultiplier(GetNormalizationGain());
+    }
+}
+
+float ULoudnessMeterComponent::GetLoudnessFeature() const
+{
+    const float Range = FMath::Max(FeatureCeilingLufs - FeatureFloorLufs, KINDA_SMALL_NUMBER);
+    return FMath::Clamp((Meter.GetMomentaryLufs() - FeatureFloorLufs) / Range, 0.f, 1.f);
+}
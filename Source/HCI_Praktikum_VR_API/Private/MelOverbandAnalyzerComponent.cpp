@@ -1,19 +1,11 @@
 ﻿// MelOverbandAnalyzerComponent.cpp
 
 #include "MelOverbandAnalyzerComponent.h"
+#include "HarmonicPercussiveComponent.h"
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
 #include "Math/UnrealMathUtility.h"
-
-// Mel ↔ Hz conversions (O’Shaughnessy)
-static inline float HzToMel(float f)
-{
-    return 2595.0f * FMath::LogX(10.0f, 1.0f + f / 700.0f);
-}
-static inline float MelToHz(float m)
-{
-    return 700.0f * (FMath::Pow(10.0f, m / 2595.0f) - 1.0f);
-}
+#include "HAL/PlatformTime.h"
 
 UMelOverbandAnalyzerComponent::UMelOverbandAnalyzerComponent()
 {
@@ -30,49 +22,131 @@ void UMelOverbandAnalyzerComponent::SetAnalyzer(
     float InLogScaleGVal,
     float InThreshAlphaVal)
 {
-    check(InAnalyzer);
+    check(InAnalyzer || Backend == EOverbandBackend::FilterBank);
     AATools = InAnalyzer;
     SampleRate = InSampleRate;
     SubBandCount = InFrameSize / 2;  // adjust if FFT returns N/2+1
     OverBandCount = InOverBandCount;
 
-    DecayEnv = InDecayEnvVal;
-    DecayPeak = InDecayPeakVal;
-    LogScaleG = InLogScaleGVal;
-    ThreshAlpha = InThreshAlphaVal;
+    Params.DecayEnv = InDecayEnvVal;
+    Params.DecayPeak = InDecayPeakVal;
+    Params.LogScaleG = InLogScaleGVal;
+    Params.ThreshAlpha = InThreshAlphaVal;
 
     // Allocate & reset state
-    EnvBuf.Init(0.f, OverBandCount);
-    PeakBuf.Init(0.f, OverBandCount);
-    ThrBuf.Init(0.f, OverBandCount);
-    LastVis.Init(0.f, OverBandCount);
-    BandEdges.SetNumUninitialized(OverBandCount + 1);
+    Processor.Init(OverBandCount, Params);
+    RawAvgBuf.SetNumZeroed(OverBandCount);
+    DebugStages.SetNum(OverBandCount);
 
     // Compute Mel‑spaced band edges
-    const float mel0 = HzToMel(0.f);
-    const float melN = HzToMel(SampleRate * 0.5f);
-    for (int32 b = 0; b <= OverBandCount; ++b)
-    {
-        float frac = float(b) / OverBandCount;
-        float m = FMath::Lerp(mel0, melN, frac);
-        float fHz = MelToHz(m);
-        int32 idx = FMath::Clamp(
-            int32((fHz / (SampleRate * 0.5f)) * SubBandCount),
-            0, SubBandCount);
-        BandEdges[b] = idx;
-    }
+    FMelOverbandProcessor::ComputeBandEdges(SubBandCount, SampleRate, OverBandCount, BandEdges);
+
+    // Filter bank on the same Mel edges, so both backends feed comparable levels.
+    TArray<float> EdgesHz;
+    FMelOverbandProcessor::ComputeBandEdgesHz(SampleRate, OverBandCount, EdgesHz);
+    FilterBank.Init(SampleRate, EdgesHz);
 
     DebugFrameCounter = 0;
     DebugCSVBuffer.Empty();
 }
 
-void UMelOverbandAnalyzerComponent::Process(TArray<float>& OutVis)
+void UMelOverbandAnalyzerComponent::Reconfigure(int32 InFrameSize, int32 InOverBandCount)
 {
-    check(AATools);
-    const TArray<float>& Mag = AATools->GetMagnitudeSpectrum();
+    // Band edges need the sample rate from SetAnalyzer
+    if (!ensureMsgf(IsInitialized(), TEXT("Reconfigure called before SetAnalyzer")))
+    {
+        return;
+    }
+
+    InOverBandCount = FMath::Max(1, InOverBandCount);
+    const int32 InSubBandCount = InFrameSize / 2;
+    const bool bBandsChanged = InOverBandCount != OverBandCount;
+    if (!bBandsChanged && InSubBandCount == SubBandCount)
+    {
+        return;
+    }
+    SubBandCount = InSubBandCount;
+
+    if (bBandsChanged)
+    {
+        Processor.ResizeBands(InOverBandCount);
+        OverBandCount = InOverBandCount;
+        RawAvgBuf.SetNumZeroed(OverBandCount);
+        DebugStages.SetNum(OverBandCount);
+    }
+
+    FMelOverbandProcessor::ComputeBandEdges(SubBandCount, SampleRate, OverBandCount, BandEdges);
+
+    // The filter bank's Hz edges do not depend on the FFT size
+    if (bBandsChanged)
+    {
+        TArray<float> EdgesHz;
+        FMelOverbandProcessor::ComputeBandEdgesHz(SampleRate, OverBandCount, EdgesHz);
+        FilterBank.Init(SampleRate, EdgesHz);
+    }
+}
+
+void UMelOverbandAnalyzerComponent::SetSmoothingCoefficients(float InAttackCoef, float InVisSmoothAlpha)
+{
+    Params.AttackCoef = FMath::Clamp(InAttackCoef, 0.f, 1.f);
+    Params.VisSmoothAlpha = FMath::Clamp(InVisSmoothAlpha, 0.f, 1.f);
+    Processor.SetParams(Params);
+}
+
+void UMelOverbandAnalyzerComponent::SetNormalization(EOverbandNormalization InMode, float InLowQuantile, float InHighQuantile, float InDecay)
+{
+    Params.Normalization = InMode;
+    Params.QuantileLow = InLowQuantile;
+    Params.QuantileHigh = InHighQuantile;
+    Params.QuantileDecay = InDecay;
+    Processor.SetParams(Params);
+}
+
+void UMelOverbandAnalyzerComponent::SetBackend(EOverbandBackend InBackend)
+{
+    Backend = InBackend;
+    FilterBank.Reset();
+}
 
+void UMelOverbandAnalyzerComponent::PushAudioSamples(const TArray<float>& AudioFrames, int32 NumChannels)
+{
+    if (Backend != EOverbandBackend::FilterBank || FilterBank.GetNumBands() == 0)
+    {
+        return;
+    }
+
+    NumChannels = FMath::Max(1, NumChannels);
+    if (NumChannels == 1)
+    {
+        FilterBank.Process(AudioFrames.GetData(), AudioFrames.Num());
+        return;
+    }
+
+    const int32 NumFrames = AudioFrames.Num() / NumChannels;
+    MonoScratch.SetNumUninitialized(NumFrames);
+    const float InvChannels = 1.f / NumChannels;
+    for (int32 i = 0; i < NumFrames; ++i)
+    {
+        float Sum = 0.f;
+        for (int32 c = 0; c < NumChannels; ++c)
+        {
+            Sum += AudioFrames[i * NumChannels + c];
+        }
+        MonoScratch[i] = Sum * InvChannels;
+    }
+    FilterBank.Process(MonoScratch.GetData(), NumFrames);
+}
+
+void UMelOverbandAnalyzerComponent::SetSpectrumSource(UHarmonicPercussiveComponent* InSeparator, EOverbandSpectrumSource InSource)
+{
+    Separator = InSeparator;
+    SpectrumSource = InSeparator ? InSource : EOverbandSpectrumSource::Mixed;
+}
+
+void UMelOverbandAnalyzerComponent::Process(TArray<float>& OutVis)
+{
+    const uint64 StartCycles = FPlatformTime::Cycles64();
     OutVis.SetNumUninitialized(OverBandCount);
-    const float invLogDen = 1.f / FMath::Loge(1.f + LogScaleG);
 
     // CSV header on first frame
     if (bDebugToCSV && DebugFrameCounter == 0)
@@ -80,51 +154,49 @@ void UMelOverbandAnalyzerComponent::Process(TArray<float>& OutVis)
         DebugCSVBuffer = TEXT("Frame,Band,RawAvg,Env,Peak,Norm,Warped,Thr,AdjRaw,Smoothed\n");
     }
 
-    for (int32 b = 0; b < OverBandCount; ++b)
+    // 1) raw average per band
+    if (Backend == EOverbandBackend::FilterBank)
+    {
+        FilterBank.GetLevels(RawAvgBuf.GetData());
+    }
+    else
+    {
+        check(AATools);
+        const TArray<float>* MagPtr = &AATools->GetMagnitudeSpectrum();
+        if (Separator && SpectrumSource != EOverbandSpectrumSource::Mixed)
+        {
+            const TArray<float>& Separated = (SpectrumSource == EOverbandSpectrumSource::Harmonic)
+                ? Separator->GetHarmonicSpectrum()
+                : Separator->GetPercussiveSpectrum();
+            // Fall back to the mixed spectrum until the separator has seen a frame.
+            if (Separated.Num() == MagPtr->Num())
+            {
+                MagPtr = &Separated;
+            }
+        }
+        // After Reconfigure the plugin may still deliver the old frame size for a
+        // hop; keep the previous band levels instead of reading past the spectrum.
+        if (MagPtr->Num() >= SubBandCount)
+        {
+            FMelOverbandProcessor::ComputeBandAverages(MagPtr->GetData(), BandEdges, RawAvgBuf.GetData());
+        }
+    }
+
+    // 2–8) envelope … exponential smoothing
+    Processor.Process(RawAvgBuf.GetData(), OutVis.GetData(), bDebugToCSV ? DebugStages.GetData() : nullptr);
+
+    LastProcessMs = float(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+
+    // 9) append debug
+    if (bDebugToCSV)
     {
-        // 1) raw average
-        int32 s = BandEdges[b], e = BandEdges[b + 1];
-        int32 cnt = FMath::Max(1, e - s);
-        float sum = 0.f;
-        for (int32 i = s; i < e; ++i) sum += Mag[i];
-        float rawAvg = sum / cnt;
-
-        // 2) envelope (attack/release)
-        float prevE = EnvBuf[b];
-        float riseE = prevE * AttackCoef + rawAvg * (1 - AttackCoef);
-        float fallE = prevE * DecayEnv;
-        float env = FMath::Max(riseE, fallE);
-        EnvBuf[b] = env;
-
-        // 3) peak tracker
-        float peak = FMath::Max(env, PeakBuf[b] * DecayPeak);
-        PeakBuf[b] = peak;
-
-        // 4) normalize
-        float norm = (peak > KINDA_SMALL_NUMBER) ? (env / peak) : 0.f;
-
-        // 5) log‑warp
-        float warped = FMath::Loge(1 + LogScaleG * norm) * invLogDen;
-
-        // 6) adaptive threshold
-        float thr = ThrBuf[b] = ThrBuf[b] * ThreshAlpha + warped * (1 - ThreshAlpha);
-
-        // 7) raw adjusted
-        float adjRaw = (warped <= thr) ? 0.f : (warped - thr) / (1 - thr);
-        adjRaw = FMath::Clamp(adjRaw, 0.f, 1.f);
-
-        // 8) exponential smoothing on final output
-        float sm = LastVis[b] * VisSmoothAlpha + adjRaw * (1 - VisSmoothAlpha);
-        LastVis[b] = sm;
-        OutVis[b] = sm;
-
-        // 9) append debug
-        if (bDebugToCSV)
+        for (int32 b = 0; b < OverBandCount; ++b)
         {
+            const FMelOverbandStageValues& St = DebugStages[b];
             DebugCSVBuffer += FString::Printf(
                 TEXT("%d,%d,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f\n"),
                 DebugFrameCounter, b,
-                rawAvg, env, peak, norm, warped, thr, adjRaw, sm
+                RawAvgBuf[b], St.Env, St.Peak, St.Norm, St.Warped, St.Thr, St.AdjRaw, OutVis[b]
             );
         }
     }
@@ -0,0 +1,185 @@
+// MelOverbandProcessor.cpp
+
+#include "MelOverbandProcessor.h"
+#include "Math/UnrealMathUtility.h"
+
+// Mel ↔ Hz conversions (O’Shaughnessy)
+static inline float HzToMel(float f)
+{
+    return 2595.0f * FMath::LogX(10.0f, 1.0f + f / 700.0f);
+}
+static inline float MelToHz(float m)
+{
+    return 700.0f * (FMath::Pow(10.0f, m / 2595.0f) - 1.0f);
+}
+
+void FMelOverbandProcessor::ComputeBandEdges(int32 NumBins, float SampleRate, int32 OverBandCount, TArray<int32>& OutEdges)
+{
+    OutEdges.SetNumUninitialized(OverBandCount + 1);
+
+    const float mel0 = HzToMel(0.f);
+    const float melN = HzToMel(SampleRate * 0.5f);
+    for (int32 b = 0; b <= OverBandCount; ++b)
+    {
+        float frac = float(b) / OverBandCount;
+        float m = FMath::Lerp(mel0, melN, frac);
+        float fHz = MelToHz(m);
+        int32 idx = FMath::Clamp(
+            int32((fHz / (SampleRate * 0.5f)) * NumBins),
+            0, NumBins);
+        OutEdges[b] = idx;
+    }
+}
+
+void FMelOverbandProcessor::ComputeBandEdgesHz(float SampleRate, int32 OverBandCount, TArray<float>& OutEdgesHz)
+{
+    OutEdgesHz.SetNumUninitialized(OverBandCount + 1);
+
+    const float mel0 = HzToMel(0.f);
+    const float melN = HzToMel(SampleRate * 0.5f);
+    for (int32 b = 0; b <= OverBandCount; ++b)
+    {
+        OutEdgesHz[b] = MelToHz(FMath::Lerp(mel0, melN, float(b) / OverBandCount));
+    }
+}
+
+void FMelOverbandProcessor::ComputeBandAverages(const float* Magnitudes, const TArray<int32>& Edges, float* OutAverages)
+{
+    for (int32 b = 0; b + 1 < Edges.Num(); ++b)
+    {
+        int32 s = Edges[b], e = Edges[b + 1];
+        int32 cnt = FMath::Max(1, e - s);
+        float sum = 0.f;
+        for (int32 i = s; i < e; ++i) sum += Magnitudes[i];
+        OutAverages[b] = sum / cnt;
+    }
+}
+
+void FMelOverbandProcessor::Init(int32 InOverBandCount, const FMelOverbandParams& InParams)
+{
+    OverBandCount = FMath::Max(0, InOverBandCount);
+    Quantiles.Init(OverBandCount, InParams.QuantileLow, InParams.QuantileHigh, InParams.QuantileDecay);
+    SetParams(InParams);
+    Reset();
+}
+
+void FMelOverbandProcessor::Reset()
+{
+    EnvBuf.Init(0.f, OverBandCount);
+    PeakBuf.Init(0.f, OverBandCount);
+    ThrBuf.Init(0.f, OverBandCount);
+    LastVis.Init(0.f, OverBandCount);
+    Quantiles.Reset();
+}
+
+static void ResampleBandState(TArray<float>& State, int32 NewCount)
+{
+    const TArray<float> Old = MoveTemp(State);
+    State.SetNumUninitialized(NewCount);
+    if (Old.Num() == 0)
+    {
+        FMemory::Memzero(State.GetData(), NewCount * sizeof(float));
+        return;
+    }
+
+    for (int32 b = 0; b < NewCount; ++b)
+    {
+        // Same relative position on the Mel axis in the old band layout.
+        const float Pos = FMath::Clamp((b + 0.5f) / NewCount * Old.Num() - 0.5f, 0.f, float(Old.Num() - 1));
+        const int32 i0 = FMath::FloorToInt(Pos);
+        const int32 i1 = FMath::Min(i0 + 1, Old.Num() - 1);
+        State[b] = FMath::Lerp(Old[i0], Old[i1], Pos - i0);
+    }
+}
+
+void FMelOverbandProcessor::ResizeBands(int32 InOverBandCount)
+{
+    InOverBandCount = FMath::Max(0, InOverBandCount);
+    if (InOverBandCount == OverBandCount)
+    {
+        return;
+    }
+
+    ResampleBandState(EnvBuf, InOverBandCount);
+    ResampleBandState(PeakBuf, InOverBandCount);
+    ResampleBandState(ThrBuf, InOverBandCount);
+    ResampleBandState(LastVis, InOverBandCount);
+    Quantiles.ResizeBands(InOverBandCount);
+    OverBandCount = InOverBandCount;
+}
+
+void FMelOverbandProcessor::SetParams(const FMelOverbandParams& InParams)
+{
+    Params = InParams;
+    Quantiles.SetQuantiles(Params.QuantileLow, Params.QuantileHigh);
+    Quantiles.SetDecay(Params.QuantileDecay);
+    InvLogDen = 1.f / FMath::Loge(1.f + Params.LogScaleG);
+}
+
+void FMelOverbandProcessor::Process(const float* RawAverages, float* OutVis, FMelOverbandStageValues* OutStages)
+{
+    const float AttackCoef = Params.AttackCoef;
+    const float DecayEnv = Params.DecayEnv;
+    const float DecayPeak = Params.DecayPeak;
+    const float LogScaleG = Params.LogScaleG;
+    const float ThreshAlpha = Params.ThreshAlpha;
+    const float VisSmoothAlpha = Params.VisSmoothAlpha;
+
+    for (int32 b = 0; b < OverBandCount; ++b)
+    {
+        const float rawAvg = RawAverages[b];
+
+        // envelope (attack/release)
+        float prevE = EnvBuf[b];
+        float riseE = prevE * AttackCoef + rawAvg * (1 - AttackCoef);
+        float fallE = prevE * DecayEnv;
+        EnvBuf[b] = FMath::Max(riseE, fallE);
+    }
+
+    const bool bQuantile = Params.Normalization == EOverbandNormalization::Quantile;
+    if (bQuantile)
+    {
+        Quantiles.Update(EnvBuf.GetData());
+    }
+
+    for (int32 b = 0; b < OverBandCount; ++b)
+    {
+        const float env = EnvBuf[b];
+
+        // peak tracker (in quantile mode it reports the high quantile)
+        float peak;
+        float norm;
+        if (bQuantile)
+        {
+            const float lo = Quantiles.GetLow(b);
+            peak = Quantiles.GetHigh(b);
+            norm = (peak - lo > KINDA_SMALL_NUMBER) ? FMath::Clamp((env - lo) / (peak - lo), 0.f, 1.f) : 0.f;
+        }
+        else
+        {
+            peak = FMath::Max(env, PeakBuf[b] * DecayPeak);
+            norm = (peak > KINDA_SMALL_NUMBER) ? (env / peak) : 0.f;
+        }
+        PeakBuf[b] = peak;
+
+        // log‑warp
+        float warped = FMath::Loge(1 + LogScaleG * norm) * InvLogDen;
+
+        // adaptive threshold
+        float thr = ThrBuf[b] = ThrBuf[b] * ThreshAlpha + warped * (1 - ThreshAlpha);
+
+        // raw adjusted
+        float adjRaw = (warped <= thr) ? 0.f : (warped - thr) / (1 - thr);
+        adjRaw = FMath::Clamp(adjRaw, 0.f, 1.f);
+
+        // exponential smoothing on final output
+        float sm = LastVis[b] * VisSmoothAlpha + adjRaw * (1 - VisSmoothAlpha);
+        LastVis[b] = sm;
+        OutVis[b] = sm;
+
+        if (OutStages)
+        {
+            OutStages[b] = { env, peak, norm, warped, thr, adjRaw };
+        }
+    }
+}
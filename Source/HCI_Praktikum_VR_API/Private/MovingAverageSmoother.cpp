@@ -0,0 +1,95 @@
+// MovingAverageSmoother.cpp
+
+#include "MovingAverageSmoother.h"
+
+void FMovingAverageWindow::Init(int32 InWindowSize)
+{
+    Samples.SetNumZeroed(FMath::Max(0, InWindowSize));
+    Reset();
+}
+
+void FMovingAverageWindow::Reset()
+{
+    Head = 0;
+    Count = 0;
+    Sum = 0.0;
+    Compensation = 0.0;
+}
+
+void FMovingAverageWindow::Accumulate(double Value)
+{
+    // Kahan summation: carry the low-order bits lost by the previous add.
+    const double Y = Value - Compensation;
+    const double T = Sum + Y;
+    Compensation = (T - Sum) - Y;
+    Sum = T;
+}
+
+float FMovingAverageWindow::Update(float NewSample)
+{
+    const int32 Capacity = Samples.Num();
+    if (Capacity == 0)
+    {
+        return 0.f;
+    }
+
+    if (Count == Capacity)
+    {
+        Accumulate(-double(Samples[Head]));
+    }
+    else
+    {
+        ++Count;
+    }
+
+    Samples[Head] = NewSample;
+    Accumulate(NewSample);
+    Head = (Head + 1 == Capacity) ? 0 : Head + 1;
+
+    return GetMean();
+}
+
+void FMovingAverageWindow::GetSamples(TArray<float>& OutSamples) const
+{
+    OutSamples.Reset(Count);
+    const int32 Capacity = Samples.Num();
+    for (int32 i = 0; i < Count; ++i)
+    {
+        OutSamples.Add(Samples[(Head - Count + i + Capacity) % Capacity]);
+    }
+}
+
+UMovingAverageSmoother* UMovingAverageSmoother::CreateMovingAverageSmoother(int32 WindowSize)
+{
+    UMovingAverageSmoother* Smoother = NewObject<UMovingAverageSmoother>();
+    Smoother->Window.Init(WindowSize);
+    return Smoother;
+}
+
+float UMovingAverageSmoother::Update(float NewSample)
+{
+    return Window.Update(NewSample);
+}
+
+void UMovingAverageSmoother::Seed(const TArray<float>& Buffer)
+{
+    Window.Reset();
+    const int32 First = FMath::Max(0, Buffer.Num() - Window.GetWindowSize());
+    for (int32 i = First; i < Buffer.Num(); ++i)
+    {
+        Window.Update(Buffer[i]);
+    }
+}
+
+void UMovingAverageSmoother::SetWindowSize(int32 WindowSize)
+{
+    if (WindowSize == Window.GetWindowSize())
+    {
+        return;
+    }
+
+    TArray<float> Kept;
+    Window.GetSamples(Kept);
+    Window.Init(WindowSize);
+    Seed(Kept);
+}
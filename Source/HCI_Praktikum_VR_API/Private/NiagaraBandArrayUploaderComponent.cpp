@@ -0,0 +1,199 @@
+// NiagaraBandArrayUploaderComponent.cpp
+
+#include "NiagaraBandArrayUploaderComponent.h"
+#include "NiagaraComponent.h"
+#include "NiagaraDataInterfaceArrayFunctionLibrary.h"
+#include "NiagaraTargetRegistrySubsystem.h"
+#include "MelOverbandAnalyzerComponent.h"
+#include "FeatureSmoothingComponent.h"
+#include "GameFramework/Actor.h"
+
+UNiagaraBandArrayUploaderComponent::UNiagaraBandArrayUploaderComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    // After the actor ticks that run the analyzer and smoothing.
+    PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void UNiagaraBandArrayUploaderComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (AActor* Owner = GetOwner())
+    {
+        if (!Analyzer)
+        {
+            Analyzer = Owner->FindComponentByClass<UMelOverbandAnalyzerComponent>();
+        }
+        if (!FeatureSource)
+        {
+            FeatureSource = Owner->FindComponentByClass<UFeatureSmoothingComponent>();
+        }
+    }
+    bDirty = true;
+}
+
+void UNiagaraBandArrayUploaderComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+    if (bAutoUpload)
+    {
+        Upload();
+    }
+}
+
+bool UNiagaraBandArrayUploaderComponent::CopyIfChanged(const float* Source, int32 Num, TArray<float>& Dest)
+{
+    if (Dest.Num() != Num)
+    {
+        Dest.SetNumUninitialized(Num, false);
+    }
+    else if (FMemory::Memcmp(Dest.GetData(), Source, Num * sizeof(float)) == 0)
+    {
+        return false;
+    }
+    FMemory::Memcpy(Dest.GetData(), Source, Num * sizeof(float));
+    return true;
+}
+
+void UNiagaraBandArrayUploaderComponent::SetBandValues(const TArray<float>& Values)
+{
+    bBandsChanged |= CopyIfChanged(Values.GetData(), Values.Num(), BandValues);
+    NumBands = BandValues.Num();
+}
+
+void UNiagaraBandArrayUploaderComponent::SetFeatureRow(int32 Row, const TArray<float>& Values)
+{
+    if (Row < 0 || NumBands == 0)
+    {
+        return;
+    }
+    const int32 Needed = (Row + 1) * NumBands;
+    if (FeatureMatrix.Num() < Needed)
+    {
+        FeatureMatrix.SetNumZeroed(Needed, false);
+        bMatrixChanged = true;
+    }
+
+    float* Dest = FeatureMatrix.GetData() + Row * NumBands;
+    const int32 Copy = FMath::Min(Values.Num(), NumBands);
+    for (int32 b = 0; b < NumBands; ++b)
+    {
+        const float Value = b < Copy ? Values[b] : 0.f;
+        bMatrixChanged |= Dest[b] != Value;
+        Dest[b] = Value;
+    }
+}
+
+void UNiagaraBandArrayUploaderComponent::PullSources()
+{
+    if (Analyzer)
+    {
+        const TArray<float>& Output = Analyzer->GetLastOutput();
+        bBandsChanged |= CopyIfChanged(Output.GetData(), Output.Num(), BandValues);
+        NumBands = BandValues.Num();
+    }
+
+    if (!FeatureSource || MatrixFeatures.Num() == 0)
+    {
+        return;
+    }
+
+    const int32 MatrixSize = MatrixFeatures.Num() * NumBands;
+    if (FeatureMatrix.Num() != MatrixSize)
+    {
+        FeatureMatrix.SetNumZeroed(MatrixSize, false);
+        bMatrixChanged = true;
+    }
+
+    FFeatureSmoothingProgram& Program = FeatureSource->GetProgram();
+    for (int32 Row = 0; Row < MatrixFeatures.Num(); ++Row)
+    {
+        const int32 Feature = Program.FindFeature(MatrixFeatures[Row]);
+        if (Feature == INDEX_NONE)
+        {
+            continue;
+        }
+        const TConstArrayView<float> Lanes = Program.GetLanes(Feature);
+        const int32 Copy = FMath::Min(Lanes.Num(), NumBands);
+        float* Dest = FeatureMatrix.GetData() + Row * NumBands;
+        if (FMemory::Memcmp(Dest, Lanes.GetData(), Copy * sizeof(float)) != 0)
+        {
+            FMemory::Memcpy(Dest, Lanes.GetData(), Copy * sizeof(float));
+            bMatrixChanged = true;
+        }
+    }
+}
+
+void UNiagaraBandArrayUploaderComponent::GatherTargets()
+{
+    Targets.Reset();
+    for (UNiagaraComponent* Component : TargetComponents)
+    {
+        if (IsValid(Component))
+        {
+            Targets.AddUnique(Component);
+        }
+    }
+
+    if (UNiagaraTargetRegistrySubsystem* Registry = UNiagaraTargetRegistrySubsystem::Get(this))
+    {
+        TArray<UNiagaraComponent*> Found;
+        for (const FString& Sub : TargetActorNameSubstrings)
+        {
+            Registry->FindNiagaraComponentsByActorName(Sub, Found);
+            for (UNiagaraComponent* Component : Found)
+            {
+                Targets.AddUnique(Component);
+            }
+        }
+        TargetRevision = Registry->GetRevision();
+    }
+}
+
+void UNiagaraBandArrayUploaderComponent::Upload()
+{
+    PullSources();
+
+    const UNiagaraTargetRegistrySubsystem* Registry = UNiagaraTargetRegistrySubsystem::Get(this);
+    const bool bTargetsChanged = bDirty || (Registry && Registry->GetRevision() != TargetRevision);
+    if (bTargetsChanged)
+    {
+        GatherTargets();
+    }
+
+    // New targets start empty, so they get everything.
+    const bool bPushBands = (bBandsChanged || bTargetsChanged) && !BandArrayParameter.IsNone();
+    const bool bPushMatrix = (bMatrixChanged || bTargetsChanged) && !FeatureMatrixParameter.IsNone() && FeatureMatrix.Num() > 0;
+    const bool bPushNumBands = (NumBands != UploadedNumBands || bTargetsChanged) && !NumBandsParameter.IsNone();
+    if (!bPushBands && !bPushMatrix && !bPushNumBands)
+    {
+        return;
+    }
+
+    for (const TWeakObjectPtr<UNiagaraComponent>& Target : Targets)
+    {
+        UNiagaraComponent* Component = Target.Get();
+        if (!Component)
+        {
+            continue;
+        }
+        if (bPushBands)
+        {
+            UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayFloat(Component, BandArrayParameter, BandValues);
+        }
+        if (bPushMatrix)
+        {
+            UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayFloat(Component, FeatureMatrixParameter, FeatureMatrix);
+        }
+        if (bPushNumBands)
+        {
+            Component->SetVariableInt(NumBandsParameter, NumBands);
+        }
+    }
+
+    UploadedNumBands = NumBands;
+    bBandsChanged = false;
+    bMatrixChanged = false;
+    bDirty = false;
+}
@@ -0,0 +1,107 @@
+// NiagaraParameterBindings.cpp
+
+#include "NiagaraParameterBindings.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "NiagaraUserRedirectionParameterStore.h"
+#include "Engine/World.h"
+
+void FNiagaraFloatParameterBindings::Init(TConstArrayView<FName> ParameterNames)
+{
+    Variables.Reset(ParameterNames.Num());
+    for (const FName Name : ParameterNames)
+    {
+        FNiagaraVariable Variable(FNiagaraTypeDefinition::GetFloatDef(), Name);
+        if (!FNiagaraUserRedirectionParameterStore::IsUserParameter(Variable))
+        {
+            FNiagaraUserRedirectionParameterStore::MakeUserVariable(Variable);
+        }
+        Variables.Add(Variable);
+    }
+    Bindings.Reset();
+}
+
+void FNiagaraFloatParameterBindings::Resolve(UNiagaraComponent* Component, FComponentBinding& Binding) const
+{
+    const FNiagaraUserRedirectionParameterStore& Store = Component->GetOverrideParameters();
+    Binding.System = Component->GetAsset();
+    Binding.LayoutSize = Store.ReadParameterVariables().Num();
+
+    Binding.Offsets.SetNumUninitialized(Variables.Num());
+    for (int32 i = 0; i < Variables.Num(); ++i)
+    {
+        Binding.Offsets[i] = Store.IndexOf(Variables[i]);
+    }
+    Binding.Shadow.Init(NAN, Variables.Num());
+}
+
+int32 FNiagaraFloatParameterBindings::Push(UNiagaraComponent* Component, TConstArrayView<float> Values, float Epsilon)
+{
+    if (!IsValid(Component) || Values.Num() < Variables.Num())
+    {
+        return 0;
+    }
+
+#if WITH_EDITOR
+    // Outside of play the values also have to land in the editor overrides,
+    // which only the named setter records.
+    const UWorld* World = Component->GetWorld();
+    if (!World || !World->IsGameWorld())
+    {
+        for (int32 i = 0; i < Variables.Num(); ++i)
+        {
+            Component->SetVariableFloat(Variables[i].GetName(), Values[i]);
+        }
+        return Variables.Num();
+    }
+#endif
+
+    FComponentBinding& Binding = Bindings.FindOrAdd(Component);
+    FNiagaraUserRedirectionParameterStore& Store = Component->GetOverrideParameters();
+    if (Binding.System.Get() != Component->GetAsset() || Binding.LayoutSize != Store.ReadParameterVariables().Num())
+    {
+        Resolve(Component, Binding);
+    }
+
+    int32 Written = 0;
+    for (int32 i = 0; i < Variables.Num(); ++i)
+    {
+        const int32 Offset = Binding.Offsets[i];
+        const float Value = Values[i];
+        // NaN shadow fails the comparison, so the first push always writes.
+        if (Offset == INDEX_NONE || FMath::Abs(Value - Binding.Shadow[i]) <= Epsilon)
+        {
+            continue;
+        }
+        Store.SetParameterData(reinterpret_cast<const uint8*>(&Value), Offset, sizeof(float));
+        Binding.Shadow[i] = Value;
+        ++Written;
+    }
+    return Written;
+}
+
+void FNiagaraFloatParameterBindings::Invalidate(UNiagaraComponent* Component)
+{
+    if (!Component)
+    {
+        for (TPair<TObjectKey<UNiagaraComponent>, FComponentBinding>& Pair : Bindings)
+        {
+            Pair.Value.Shadow.Init(NAN, Variables.Num());
+        }
+    }
+    else if (FComponentBinding* Binding = Bindings.Find(Component))
+    {
+        Binding->Shadow.Init(NAN, Variables.Num());
+    }
+}
+
+void FNiagaraFloatParameterBindings::PruneStale()
+{
+    for (auto It = Bindings.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().ResolveObjectPtr())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
@@ -2,13 +2,34 @@
 #include "NiagaraComponent.h"
 #include "GameFramework/Actor.h"
 #include "Engine/World.h"
-#include "EngineUtils.h"
+#include "NiagaraTargetRegistrySubsystem.h"
+#include "NiagaraSimValueProviders.h"
 #include "UObject/UnrealType.h"    // For FProperty, FFloatProperty
 #include "Logging/LogMacros.h"
 
 UNiagaraSimControllerComponent::UNiagaraSimControllerComponent()
 {
-    PrimaryComponentTick.bCanEverTick = false;
+    // Ticks only in realtime mode
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+
+    static const FName SimParameterNames[] =
+    {
+        TEXT("User.Sim_Colorintensity"),
+        TEXT("User.Sim_Conduction_Strength"),
+        TEXT("User.Sim_Conduction_visMultiplier"),
+        TEXT("User.Sim_LeftHand_ForceFallOffDistance"),
+        TEXT("User.Sim_LeftHand_ForceStrength"),
+        TEXT("User.Sim_Pawn_ForceFallOffDistance"),
+        TEXT("User.Sim_Pawn_ForceStrength"),
+        TEXT("User.Sim_RightHand_ForceFallOffDistance"),
+        TEXT("User.Sim_RightHand_ForceStrength"),
+        TEXT("User.Sim_Vortex_AttractionStrength"),
+        TEXT("User.Sim_Vortex_InnerRadius"),
+        TEXT("User.Sim_Vortex_OuterRadius"),
+        TEXT("User.Sim_Vortex_RotationStrength"),
+    };
+    SimParameterBindings.Init(SimParameterNames);
 }
 
 void UNiagaraSimControllerComponent::BeginPlay()
@@ -17,6 +38,194 @@ void UNiagaraSimControllerComponent::BeginPlay()
     // You can choose to call one or both at startup:
     ApplyNiagaraParameters();
     ApplyFireflyStatistics();
+
+    // Remember what was just pushed so realtime mode starts from here
+    GatherSimValues(LastSimValues);
+    GatherStatisticValues(LastStatisticValues);
+    if (const UNiagaraTargetRegistrySubsystem* Registry = UNiagaraTargetRegistrySubsystem::Get(this))
+    {
+        LastRegistryRevision = Registry->GetRevision();
+    }
+
+    InitializeValueBindings();
+    SetRealtimeUpdate(bRealtimeUpdate, UpdateRateHz);
+}
+
+void UNiagaraSimControllerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    // DeltaTime spans the whole tick interval
+    RealtimeSeconds += DeltaTime;
+    for (const FNiagaraSimValueBinding& Binding : ValueBindings)
+    {
+        if (Binding.Provider && Binding.ResolvedProperty)
+        {
+            const float Value = Binding.Provider->Evaluate(RealtimeSeconds, DeltaTime) * Binding.Scale + Binding.Offset;
+            Binding.ResolvedProperty->SetPropertyValue_InContainer(this, Value);
+        }
+    }
+
+    // New or removed targets need a push even if no value moved
+    const UNiagaraTargetRegistrySubsystem* Registry = UNiagaraTargetRegistrySubsystem::Get(this);
+    const uint32 Revision = Registry ? Registry->GetRevision() : 0;
+    const bool bTargetsChanged = Revision != LastRegistryRevision;
+    LastRegistryRevision = Revision;
+
+    float SimValues[NumSimParameters];
+    GatherSimValues(SimValues);
+    if (ConsumeChanges(SimValues, LastSimValues, NumSimParameters) || bTargetsChanged)
+    {
+        ApplyNiagaraParameters();
+    }
+
+    float StatisticValues[NumStatisticParameters];
+    GatherStatisticValues(StatisticValues);
+    if (ConsumeChanges(StatisticValues, LastStatisticValues, NumStatisticParameters) || bTargetsChanged)
+    {
+        ApplyFireflyStatistics();
+    }
+}
+
+void UNiagaraSimControllerComponent::SetRealtimeUpdate(bool bEnable, float InUpdateRateHz)
+{
+    if (bEnable && !IsComponentTickEnabled())
+    {
+        RealtimeSeconds = 0.0f;
+    }
+    bRealtimeUpdate = bEnable;
+    UpdateRateHz = FMath::Max(0.0f, InUpdateRateHz);
+
+    SetTickGroup(RealtimeTickGroup);
+    SetComponentTickInterval(UpdateRateHz > 0.0f ? 1.0f / UpdateRateHz : 0.0f);
+    SetComponentTickEnabled(bEnable);
+}
+
+void UNiagaraSimControllerComponent::InitializeValueBindings()
+{
+    for (FNiagaraSimValueBinding& Binding : ValueBindings)
+    {
+        Binding.ResolvedProperty = FindFProperty<FFloatProperty>(GetClass(), Binding.Property);
+        if (!Binding.ResolvedProperty)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("NiagaraSimController: %s is not a float property"), *Binding.Property.ToString());
+        }
+        if (Binding.Provider)
+        {
+            Binding.Provider->Initialize(this);
+        }
+    }
+}
+
+TArray<FString> UNiagaraSimControllerComponent::GetBindablePropertyNames()
+{
+    TArray<FString> Names;
+    for (TFieldIterator<FFloatProperty> It(StaticClass()); It; ++It)
+    {
+        const FString Name = It->GetName();
+        if (Name.StartsWith(TEXT("Sim_"), ESearchCase::CaseSensitive) || Name.StartsWith(TEXT("default_"), ESearchCase::CaseSensitive))
+        {
+            Names.Add(Name);
+        }
+    }
+    return Names;
+}
+
+void UNiagaraSimControllerComponent::GatherSimValues(float* OutValues) const
+{
+    // Same order as SimParameterNames
+    const float Values[NumSimParameters] =
+    {
+        Sim_Colorintensity,
+        Sim_Conduction_Strength,
+        Sim_Conduction_visMultiplier,
+        Sim_LeftHand_ForceFallOffDistance,
+        Sim_LeftHand_ForceStrength,
+        Sim_Pawn_ForceFallOffDistance,
+        Sim_Pawn_ForceStrength,
+        Sim_RightHand_ForceFallOffDistance,
+        Sim_RightHand_ForceStrength,
+        Sim_Vortex_AttractionStrength,
+        Sim_Vortex_InnerRadius,
+        Sim_Vortex_OuterRadius,
+        Sim_Vortex_RotationStrength,
+    };
+    FMemory::Memcpy(OutValues, Values, sizeof(Values));
+}
+
+void UNiagaraSimControllerComponent::GatherStatisticValues(float* OutValues) const
+{
+    const float Values[NumStatisticParameters] =
+    {
+        default_RootSquare,
+        default_Crest,
+        default_Zero,
+        default_Complex,
+        default_CSD,
+        default_Centroid,
+        default_Flatness,
+        default_EnergyDifference,
+    };
+    FMemory::Memcpy(OutValues, Values, sizeof(Values));
+}
+
+const UNiagaraSimControllerComponent::FStatisticPropertyTable& UNiagaraSimControllerComponent::GetStatisticPropertyTable(UClass* Cls)
+{
+    if (const FStatisticPropertyTable* Cached = StatisticPropertyTables.Find(Cls))
+    {
+        return *Cached;
+    }
+
+    // Same order as GatherStatisticValues
+    static const FName StatisticPropertyNames[NumStatisticParameters] =
+    {
+        TEXT("default_RootSquare"),
+        TEXT("default_Crest"),
+        TEXT("default_Zero"),
+        TEXT("default_Complex"),
+        TEXT("default_CSD"),
+        TEXT("default_Centroid"),
+        TEXT("default_Flatness"),
+        TEXT("default_EnergyDifference"),
+    };
+
+    // Resolved (and warned about) once per class; Blueprint float variables are doubles
+    FStatisticPropertyTable& Table = StatisticPropertyTables.Add(Cls);
+    for (int32 i = 0; i < NumStatisticParameters; ++i)
+    {
+        const FName PropName = StatisticPropertyNames[i];
+        FProperty* P = Cls->FindPropertyByName(PropName);
+        if (const FFloatProperty* FP = CastField<FFloatProperty>(P))
+        {
+            Table.Slots[i] = { FP->GetOffset_ForInternal(), false };
+        }
+        else if (const FDoubleProperty* DP = CastField<FDoubleProperty>(P))
+        {
+            Table.Slots[i] = { DP->GetOffset_ForInternal(), true };
+        }
+        else if (P)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Prop %s on %s not float"), *PropName.ToString(), *Cls->GetName());
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Prop %s not found on %s"), *PropName.ToString(), *Cls->GetName());
+        }
+    }
+    return Table;
+}
+
+bool UNiagaraSimControllerComponent::ConsumeChanges(const float* Current, float* Last, int32 Num) const
+{
+    for (int32 i = 0; i < Num; ++i)
+    {
+        if (FMath::Abs(Current[i] - Last[i]) > ParameterEpsilon)
+        {
+            FMemory::Memcpy(Last, Current, Num * sizeof(float));
+            return true;
+        }
+    }
+    return false;
 }
 
 void UNiagaraSimControllerComponent::ApplyNiagaraParameters()
@@ -28,6 +237,9 @@ void UNiagaraSimControllerComponent::ApplyNiagaraParameters()
         return;
     }
 
+    // Null in worlds without the subsystem (e.g. editor previews); substring lookups are skipped there
+    UNiagaraTargetRegistrySubsystem* Registry = UNiagaraTargetRegistrySubsystem::Get(this);
+
     // Gather all NiagaraComponents in a set
     TSet<UNiagaraComponent*> CompsToUpdate;
 
@@ -41,53 +253,38 @@ void UNiagaraSimControllerComponent::ApplyNiagaraParameters()
             if (C->IsRegistered()) CompsToUpdate.Add(C);
     }
 
-    // 2) Actor‑name substring search
-    for (const FString& Sub : TargetNiagaraActorNameSubstrings)
+    // 2) Actor‑name substring lookup (registry keeps the matches up to date)
+    TArray<UNiagaraComponent*> Found;
+    if (Registry)
     {
-        for (TActorIterator<AActor> It(World); It; ++It)
+        for (const FString& Sub : TargetNiagaraActorNameSubstrings)
         {
-            AActor* A = *It;
-            if (!IsValid(A) || !A->GetName().Contains(Sub)) continue;
-            TArray<UNiagaraComponent*> Comps;
-            A->GetComponents<UNiagaraComponent>(Comps);
-            for (UNiagaraComponent* C : Comps)
-                if (C->IsRegistered()) CompsToUpdate.Add(C);
+            Registry->FindNiagaraComponentsByActorName(Sub, Found);
+            CompsToUpdate.Append(Found);
         }
-    }
 
-    // 3) Component‑name substring search
-    for (const FString& Sub : TargetNiagaraComponentNameSubstrings)
-    {
-        for (TObjectIterator<UNiagaraComponent> It; It; ++It)
+        // 3) Component‑name substring lookup, limited to this world
+        for (const FString& Sub : TargetNiagaraComponentNameSubstrings)
         {
-            UNiagaraComponent* C = *It;
-            if (!IsValid(C) || !C->IsRegistered()) continue;
-            if (C->GetName().Contains(Sub))
-                CompsToUpdate.Add(C);
+            Registry->FindNiagaraComponentsByName(Sub, Found);
+            CompsToUpdate.Append(Found);
         }
     }
 
     // Apply your Sim_… parameters
+    float SimValues[NumSimParameters];
+    GatherSimValues(SimValues);
+
     int32 Count = 0;
+    int32 Written = 0;
     for (UNiagaraComponent* C : CompsToUpdate)
     {
-        C->SetVariableFloat(TEXT("User.Sim_Colorintensity"), Sim_Colorintensity);
-        C->SetVariableFloat(TEXT("User.Sim_Conduction_Strength"), Sim_Conduction_Strength);
-        C->SetVariableFloat(TEXT("User.Sim_Conduction_visMultiplier"), Sim_Conduction_visMultiplier);
-        C->SetVariableFloat(TEXT("User.Sim_LeftHand_ForceFallOffDistance"), Sim_LeftHand_ForceFallOffDistance);
-        C->SetVariableFloat(TEXT("User.Sim_LeftHand_ForceStrength"), Sim_LeftHand_ForceStrength);
-        C->SetVariableFloat(TEXT("User.Sim_Pawn_ForceFallOffDistance"), Sim_Pawn_ForceFallOffDistance);
-        C->SetVariableFloat(TEXT("User.Sim_Pawn_ForceStrength"), Sim_Pawn_ForceStrength);
-        C->SetVariableFloat(TEXT("User.Sim_RightHand_ForceFallOffDistance"), Sim_RightHand_ForceFallOffDistance);
-        C->SetVariableFloat(TEXT("User.Sim_RightHand_ForceStrength"), Sim_RightHand_ForceStrength);
-        C->SetVariableFloat(TEXT("User.Sim_Vortex_AttractionStrength"), Sim_Vortex_AttractionStrength);
-        C->SetVariableFloat(TEXT("User.Sim_Vortex_InnerRadius"), Sim_Vortex_InnerRadius);
-        C->SetVariableFloat(TEXT("User.Sim_Vortex_OuterRadius"), Sim_Vortex_OuterRadius);
-        C->SetVariableFloat(TEXT("User.Sim_Vortex_RotationStrength"), Sim_Vortex_RotationStrength);
+        Written += SimParameterBindings.Push(C, MakeArrayView(SimValues), ParameterEpsilon);
         ++Count;
     }
+    SimParameterBindings.PruneStale();
 
-    UE_LOG(LogTemp, Log, TEXT("ApplyNiagaraParameters: updated %d NiagaraComponents"), Count);
+    UE_LOG(LogTemp, Verbose, TEXT("ApplyNiagaraParameters: updated %d NiagaraComponents (%d values written)"), Count, Written);
 }
 
 void UNiagaraSimControllerComponent::ApplyFireflyStatistics()
@@ -108,56 +305,38 @@ void UNiagaraSimControllerComponent::ApplyFireflyStatistics()
             ActorsToUpdate.Add(A);
 
     // 2) Actor‑name substring
-    for (const FString& Sub : TargetFireflyNameSubstrings)
+    if (UNiagaraTargetRegistrySubsystem* Registry = UNiagaraTargetRegistrySubsystem::Get(this))
     {
-        for (TActorIterator<AActor> It(World); It; ++It)
+        TArray<AActor*> Found;
+        for (const FString& Sub : TargetFireflyNameSubstrings)
         {
-            AActor* A = *It;
-            if (IsValid(A) && A->GetName().Contains(Sub))
-                ActorsToUpdate.Add(A);
+            Registry->FindActorsByName(Sub, Found);
+            ActorsToUpdate.Append(Found);
         }
     }
 
-    // For each actor, reflectively set float properties:
+    // For each actor, write the statistics through its class's cached offset table
+    float Values[NumStatisticParameters];
+    GatherStatisticValues(Values);
+
     int32 Count = 0;
     for (AActor* A : ActorsToUpdate)
     {
-        UClass* Cls = A->GetClass();
-        auto SetFloatProp = [&](FName PropName, float Value)
-            {
-                if (FProperty* P = Cls->FindPropertyByName(PropName))
-                {
-                    if (FFloatProperty* FP = CastField<FFloatProperty>(P))
-                    {
-                        void* Addr = FP->ContainerPtrToValuePtr<void>(A);
-                        FP->SetFloatingPointPropertyValue(Addr, Value);
-                    }
-                    else
-                    {
-                        UE_LOG(LogTemp, Warning, TEXT("Prop %s on %s not float"),
-                            *PropName.ToString(), *A->GetName());
-                    }
-                }
-                else
-                {
-                    UE_LOG(LogTemp, Warning, TEXT("Prop %s not found on %s"),
-                        *PropName.ToString(), *A->GetName());
-                }
-            };
-
-        SetFloatProp(TEXT("default_RootSquare"), default_RootSquare);
-        SetFloatProp(TEXT("default_Crest"), default_Crest);
-        SetFloatProp(TEXT("default_Zero"), default_Zero);
-        SetFloatProp(TEXT("default_Complex"), default_Complex);
-        SetFloatProp(TEXT("default_CSD"), default_CSD);
-        SetFloatProp(TEXT("default_Centroid"), default_Centroid);
-        SetFloatProp(TEXT("default_Flatness"), default_Flatness);
-        SetFloatProp(TEXT("default_EnergyDifference"), default_EnergyDifference);
-
+        const FStatisticPropertyTable& Table = GetStatisticPropertyTable(A->GetClass());
+        uint8* Base = reinterpret_cast<uint8*>(A);
+        for (int32 i = 0; i < NumStatisticParameters; ++i)
+        {
+            const FStatisticPropertyTable::FSlot Slot = Table.Slots[i];
+            if (Slot.Offset == INDEX_NONE) continue;
+            if (Slot.bDouble)
+                *reinterpret_cast<double*>(Base + Slot.Offset) = Values[i];
+            else
+                *reinterpret_cast<float*>(Base + Slot.Offset) = Values[i];
+        }
         ++Count;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("ApplyFireflyStatistics: updated %d actors"), Count);
+    UE_LOG(LogTemp, Verbose, TEXT("ApplyFireflyStatistics: updated %d actors"), Count);
 }
 
 void UNiagaraSimControllerComponent::ApplyAllParameters()
@@ -0,0 +1,115 @@
+// NiagaraSimValueProviders.cpp
+
+#include "NiagaraSimValueProviders.h"
+#include "MelOverbandAnalyzerComponent.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogNiagaraSimProviders, Log, All);
+
+float UNiagaraSimCurveProvider::Evaluate_Implementation(float TimeSeconds, float DeltaSeconds)
+{
+    const FRichCurve* Rich = Curve.GetRichCurveConst();
+    if (!Rich || Rich->GetNumKeys() == 0)
+    {
+        return 0.f;
+    }
+
+    float T = TimeSeconds;
+    if (bLoop)
+    {
+        float MinTime, MaxTime;
+        Rich->GetTimeRange(MinTime, MaxTime);
+        const float Length = MaxTime - MinTime;
+        if (Length > KINDA_SMALL_NUMBER)
+        {
+            T = MinTime + FMath::Fmod(FMath::Max(0.f, T - MinTime), Length);
+        }
+    }
+    return Rich->Eval(T);
+}
+
+void UNiagaraSimAnalyzerProvider::Initialize(UActorComponent* Controller)
+{
+    const AActor* Source = SourceActor ? SourceActor.Get() : Controller->GetOwner();
+    Analyzer = Source ? Source->FindComponentByClass<UMelOverbandAnalyzerComponent>() : nullptr;
+    if (!Analyzer.IsValid())
+    {
+        UE_LOG(LogNiagaraSimProviders, Warning, TEXT("%s: no MelOverbandAnalyzerComponent on %s."), *GetNameSafe(Controller->GetOwner()), *GetNameSafe(Source));
+    }
+}
+
+float UNiagaraSimAnalyzerProvider::Evaluate_Implementation(float TimeSeconds, float DeltaSeconds)
+{
+    const UMelOverbandAnalyzerComponent* Source = Analyzer.Get();
+    if (!Source)
+    {
+        return 0.f;
+    }
+
+    const TArray<float>& Bands = Source->GetLastOutput();
+    if (Band >= 0)
+    {
+        return Bands.IsValidIndex(Band) ? Bands[Band] : 0.f;
+    }
+
+    float Sum = 0.f;
+    for (const float Value : Bands)
+    {
+        Sum += Value;
+    }
+    return Bands.Num() > 0 ? Sum / Bands.Num() : 0.f;
+}
+
+void UNiagaraSimTrackedComponentProvider::Initialize(UActorComponent* Controller)
+{
+    AActor* Owner = Controller->GetOwner();
+    const AActor* Source = SourceActor ? SourceActor.Get() : Owner;
+    OwnerRoot = Owner ? Owner->GetRootComponent() : nullptr;
+    Tracked = nullptr;
+    bHasLastLocation = false;
+
+    if (Source)
+    {
+        if (ComponentTag.IsNone())
+        {
+            Tracked = Source->GetRootComponent();
+        }
+        else
+        {
+            Tracked = Cast<USceneComponent>(Source->FindComponentByTag(USceneComponent::StaticClass(), ComponentTag));
+        }
+    }
+    if (!Tracked.IsValid())
+    {
+        UE_LOG(LogNiagaraSimProviders, Warning, TEXT("%s: no scene component tagged %s on %s."), *GetNameSafe(Owner), *ComponentTag.ToString(), *GetNameSafe(Source));
+    }
+}
+
+float UNiagaraSimTrackedComponentProvider::Evaluate_Implementation(float TimeSeconds, float DeltaSeconds)
+{
+    const USceneComponent* Component = Tracked.Get();
+    if (!Component)
+    {
+        return 0.f;
+    }
+
+    const FVector Location = Component->GetComponentLocation();
+    switch (Measure)
+    {
+    case ENiagaraSimTrackedMeasure::Speed:
+    {
+        const float Speed = (bHasLastLocation && DeltaSeconds > KINDA_SMALL_NUMBER)
+            ? FVector::Dist(Location, LastLocation) / DeltaSeconds
+            : 0.f;
+        LastLocation = Location;
+        bHasLastLocation = true;
+        return Speed;
+    }
+    case ENiagaraSimTrackedMeasure::DistanceToOwner:
+        return OwnerRoot.IsValid() ? FVector::Dist(Location, OwnerRoot->GetComponentLocation()) : 0.f;
+    case ENiagaraSimTrackedMeasure::Height:
+        return Location.Z;
+    }
+    return 0.f;
+}
@@ -0,0 +1,345 @@
+// NiagaraTargetRegistrySubsystem.cpp
+
+#include "NiagaraTargetRegistrySubsystem.h"
+#include "NiagaraComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogNiagaraTargetRegistry, Log, All);
+
+UNiagaraTargetRegistrySubsystem* UNiagaraTargetRegistrySubsystem::Get(const UObject* WorldContextObject)
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UNiagaraTargetRegistrySubsystem>() : nullptr;
+}
+
+void UNiagaraTargetRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UWorld* World = GetWorld();
+    ActorSpawnedHandle = World->AddOnActorSpawnedHandler(
+        FOnActorSpawned::FDelegate::CreateUObject(this, &UNiagaraTargetRegistrySubsystem::HandleActorSpawned));
+    ActorDestroyedHandle = World->AddOnActorDestroyededHandler(
+        FOnActorDestroyed::FDelegate::CreateUObject(this, &UNiagaraTargetRegistrySubsystem::HandleActorDestroyed));
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UNiagaraTargetRegistrySubsystem::HandleLevelAdded);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UNiagaraTargetRegistrySubsystem::HandleLevelRemoved);
+    WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UNiagaraTargetRegistrySubsystem::HandleWorldTickStart);
+}
+
+void UNiagaraTargetRegistrySubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+    }
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+    FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+
+    Actors.Empty();
+    Components.Empty();
+    DeferredSpawns.Empty();
+    ActorQueries.Empty();
+    ComponentQueries.Empty();
+    bSeeded = false;
+
+    Super::Deinitialize();
+}
+
+void UNiagaraTargetRegistrySubsystem::EnsureSeeded()
+{
+    if (bSeeded)
+    {
+        return;
+    }
+    bSeeded = true;
+
+    // The only full scan; everything after this is incremental.
+    for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+    {
+        AddActor(*It);
+    }
+    UE_LOG(LogNiagaraTargetRegistry, Log, TEXT("Indexed %d actors, %d Niagara components."), Actors.Num(), Components.Num());
+}
+
+void UNiagaraTargetRegistrySubsystem::RefreshDeferredSpawns()
+{
+    for (int32 i = DeferredSpawns.Num() - 1; i >= 0; --i)
+    {
+        AActor* Actor = DeferredSpawns[i].Get();
+        if (Actor && !Actor->IsActorInitialized())
+        {
+            continue; // FinishSpawning not called yet
+        }
+        if (Actor)
+        {
+            RefreshActor(Actor);
+        }
+        DeferredSpawns.RemoveAtSwap(i, 1, false);
+    }
+}
+
+void UNiagaraTargetRegistrySubsystem::AddActor(AActor* Actor)
+{
+    if (!IsValid(Actor) || Actors.Contains(Actor))
+    {
+        return;
+    }
+
+    FIndexedActor& Entry = Actors.Add(Actor);
+    Entry.Actor = Actor;
+    Entry.Name = Actor->GetName();
+
+    for (TPair<FString, TSet<TObjectKey<AActor>>>& Query : ActorQueries)
+    {
+        if (Entry.Name.Contains(Query.Key))
+        {
+            Query.Value.Add(Actor);
+        }
+    }
+
+    TInlineComponentArray<UNiagaraComponent*> NiagaraComponents(Actor);
+    for (UNiagaraComponent* Component : NiagaraComponents)
+    {
+        AddComponent(Component);
+    }
+    ++Revision;
+}
+
+void UNiagaraTargetRegistrySubsystem::RemoveActor(AActor* Actor)
+{
+    FIndexedActor Entry;
+    if (!Actors.RemoveAndCopyValue(Actor, Entry))
+    {
+        return;
+    }
+
+    for (TPair<FString, TSet<TObjectKey<AActor>>>& Query : ActorQueries)
+    {
+        Query.Value.Remove(Actor);
+    }
+    for (const TObjectKey<UNiagaraComponent>& Key : Entry.Components)
+    {
+        Components.Remove(Key);
+        for (TPair<FString, TSet<TObjectKey<UNiagaraComponent>>>& Query : ComponentQueries)
+        {
+            Query.Value.Remove(Key);
+        }
+    }
+    ++Revision;
+}
+
+void UNiagaraTargetRegistrySubsystem::AddComponent(UNiagaraComponent* Component)
+{
+    if (!IsValid(Component) || Components.Contains(Component))
+    {
+        return;
+    }
+
+    FIndexedComponent& Entry = Components.Add(Component);
+    Entry.Component = Component;
+    Entry.Owner = Component->GetOwner();
+    Entry.Name = Component->GetName();
+
+    if (FIndexedActor* Owner = Actors.Find(Entry.Owner))
+    {
+        Owner->Components.Add(Component);
+    }
+
+    for (TPair<FString, TSet<TObjectKey<UNiagaraComponent>>>& Query : ComponentQueries)
+    {
+        if (Entry.Name.Contains(Query.Key))
+        {
+            Query.Value.Add(Component);
+        }
+    }
+    ++Revision;
+}
+
+void UNiagaraTargetRegistrySubsystem::RemoveComponent(const TObjectKey<UNiagaraComponent>& Key)
+{
+    FIndexedComponent Entry;
+    if (!Components.RemoveAndCopyValue(Key, Entry))
+    {
+        return;
+    }
+
+    if (FIndexedActor* Owner = Actors.Find(Entry.Owner))
+    {
+        Owner->Components.RemoveSwap(Key);
+    }
+    for (TPair<FString, TSet<TObjectKey<UNiagaraComponent>>>& Query : ComponentQueries)
+    {
+        Query.Value.Remove(Key);
+    }
+    ++Revision;
+}
+
+void UNiagaraTargetRegistrySubsystem::RegisterNiagaraComponent(UNiagaraComponent* Component)
+{
+    EnsureSeeded();
+    RefreshDeferredSpawns();
+    if (Component && Component->GetOwner())
+    {
+        AddActor(Component->GetOwner());
+    }
+    AddComponent(Component);
+}
+
+void UNiagaraTargetRegistrySubsystem::UnregisterNiagaraComponent(UNiagaraComponent* Component)
+{
+    RemoveComponent(TObjectKey<UNiagaraComponent>(Component));
+}
+
+void UNiagaraTargetRegistrySubsystem::RefreshActor(AActor* Actor)
+{
+    RemoveActor(Actor);
+    AddActor(Actor);
+}
+
+void UNiagaraTargetRegistrySubsystem::FindActorsByName(const FString& Substring, TArray<AActor*>& OutActors)
+{
+    EnsureSeeded();
+    RefreshDeferredSpawns();
+    OutActors.Reset();
+
+    TSet<TObjectKey<AActor>>* Matches = ActorQueries.Find(Substring);
+    if (!Matches)
+    {
+        Matches = &ActorQueries.Add(Substring);
+        for (const TPair<TObjectKey<AActor>, FIndexedActor>& Pair : Actors)
+        {
+            if (Pair.Value.Name.Contains(Substring))
+            {
+                Matches->Add(Pair.Key);
+            }
+        }
+    }
+
+    for (const TObjectKey<AActor>& Key : *Matches)
+    {
+        if (AActor* Actor = Key.ResolveObjectPtr(); IsValid(Actor))
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
+
+void UNiagaraTargetRegistrySubsystem::FindNiagaraComponentsByActorName(const FString& Substring, TArray<UNiagaraComponent*>& OutComponents)
+{
+    TArray<AActor*> MatchingActors;
+    FindActorsByName(Substring, MatchingActors);
+
+    OutComponents.Reset();
+    for (AActor* Actor : MatchingActors)
+    {
+        const FIndexedActor* Entry = Actors.Find(Actor);
+        if (!Entry)
+        {
+            continue;
+        }
+        for (const TObjectKey<UNiagaraComponent>& Key : Entry->Components)
+        {
+            UNiagaraComponent* Component = Key.ResolveObjectPtr();
+            if (IsValid(Component) && Component->IsRegistered())
+            {
+                OutComponents.Add(Component);
+            }
+        }
+    }
+}
+
+void UNiagaraTargetRegistrySubsystem::FindNiagaraComponentsByName(const FString& Substring, TArray<UNiagaraComponent*>& OutComponents)
+{
+    EnsureSeeded();
+    RefreshDeferredSpawns();
+    OutComponents.Reset();
+
+    TSet<TObjectKey<UNiagaraComponent>>* Matches = ComponentQueries.Find(Substring);
+    if (!Matches)
+    {
+        Matches = &ComponentQueries.Add(Substring);
+        for (const TPair<TObjectKey<UNiagaraComponent>, FIndexedComponent>& Pair : Components)
+        {
+            if (Pair.Value.Name.Contains(Substring))
+            {
+                Matches->Add(Pair.Key);
+            }
+        }
+    }
+
+    TArray<TObjectKey<UNiagaraComponent>, TInlineAllocator<8>> Stale;
+    for (const TObjectKey<UNiagaraComponent>& Key : *Matches)
+    {
+        UNiagaraComponent* Component = Key.ResolveObjectPtr();
+        if (!IsValid(Component))
+        {
+            Stale.Add(Key); // destroyed on its own, e.g. auto-destroy after finishing
+        }
+        else if (Component->IsRegistered())
+        {
+            OutComponents.Add(Component);
+        }
+    }
+
+    for (const TObjectKey<UNiagaraComponent>& Key : Stale)
+    {
+        RemoveComponent(Key);
+    }
+}
+
+void UNiagaraTargetRegistrySubsystem::HandleActorSpawned(AActor* Actor)
+{
+    if (!bSeeded)
+    {
+        return;
+    }
+    AddActor(Actor);
+
+    // SpawnActorDeferred broadcasts before FinishSpawning has added the Blueprint components.
+    if (IsValid(Actor) && !Actor->IsActorInitialized())
+    {
+        DeferredSpawns.Add(Actor);
+    }
+}
+
+void UNiagaraTargetRegistrySubsystem::HandleActorDestroyed(AActor* Actor)
+{
+    RemoveActor(Actor);
+}
+
+void UNiagaraTargetRegistrySubsystem::HandleLevelAdded(ULevel* Level, UWorld* World)
+{
+    if (!bSeeded || World != GetWorld() || !Level)
+    {
+        return;
+    }
+    for (AActor* Actor : Level->Actors)
+    {
+        AddActor(Actor);
+    }
+}
+
+void UNiagaraTargetRegistrySubsystem::HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (World == GetWorld() && DeferredSpawns.Num() > 0)
+    {
+        RefreshDeferredSpawns();
+    }
+}
+
+void UNiagaraTargetRegistrySubsystem::HandleLevelRemoved(ULevel* Level, UWorld* World)
+{
+    if (World != GetWorld() || !Level)
+    {
+        return;
+    }
+    for (AActor* Actor : Level->Actors)
+    {
+        RemoveActor(Actor);
+    }
+}
@@ -0,0 +1,217 @@
+// OfflineSpectrogram.cpp
+
+#include "OfflineSpectrogram.h"
+#include "DecodedPcmCache.h"
+#include "SongLibrarySubsystem.h"
+#include "DSP/AlignedBuffer.h"
+#include "DSP/FFTAlgorithm.h"
+#include "HAL/FileManager.h"
+#include "Serialization/Archive.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOfflineSpectrogram, Log, All);
+
+namespace OfflineSpectrogram
+{
+    static constexpr uint32 Magic = 0x43455053; // "SPEC"
+    static constexpr int32 Version = 1;
+}
+
+bool FOfflineSpectrogram::Compute(const FMappedDecodedPcm& Pcm, int32 InFrameSize, int32 InHopSize)
+{
+    if (!Pcm.IsOpen() || !FMath::IsPowerOfTwo(InFrameSize) || InHopSize <= 0)
+    {
+        return false;
+    }
+
+    Audio::FFFTSettings Settings;
+    Settings.Log2Size = FMath::FloorLog2(uint32(InFrameSize));
+    Settings.bArrays128BitAligned = true;
+    Settings.bEnableHardwareAcceleration = true;
+    TUniquePtr<Audio::IFFTAlgorithm> FFT = Audio::FFFTFactory::NewFFTAlgorithm(Settings);
+    if (!FFT)
+    {
+        UE_LOG(LogOfflineSpectrogram, Error, TEXT("No FFT available for size %d."), InFrameSize);
+        return false;
+    }
+
+    const FDecodedPcmHeader& Header = Pcm.GetHeader();
+    const int32 Channels = int32(Header.NumChannels);
+    const int64 TotalFrames = int64(Header.NumFrames);
+
+    FrameSize = InFrameSize;
+    HopSize = InHopSize;
+    NumBins = FrameSize / 2 + 1;
+    SampleRate = float(Header.SampleRate);
+    NumFrames = TotalFrames >= FrameSize ? int32((TotalFrames - FrameSize) / HopSize + 1) : 0;
+    Magnitudes.SetNumUninitialized(int64(NumFrames) * NumBins);
+
+    TArray<float> Window;
+    Window.SetNumUninitialized(FrameSize);
+    for (int32 i = 0; i < FrameSize; ++i)
+    {
+        Window[i] = 0.5f - 0.5f * FMath::Cos(2.f * PI * i / FrameSize);
+    }
+
+    TArray<float> Interleaved;
+    Interleaved.SetNumUninitialized(FrameSize * Channels);
+    Audio::FAlignedFloatBuffer TimeDomain;
+    TimeDomain.SetNumUninitialized(FrameSize);
+    Audio::FAlignedFloatBuffer Complex;
+    Complex.SetNumUninitialized(FFT->NumOutputFloats());
+
+    const float InvChannels = 1.f / Channels;
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        Pcm.ReadFloat(int64(Frame) * HopSize * Channels, Interleaved.GetData(), Interleaved.Num());
+        for (int32 i = 0; i < FrameSize; ++i)
+        {
+            float Sum = 0.f;
+            for (int32 c = 0; c < Channels; ++c)
+            {
+                Sum += Interleaved[i * Channels + c];
+            }
+            TimeDomain[i] = Sum * InvChannels * Window[i];
+        }
+
+        FFT->ForwardRealToComplex(TimeDomain.GetData(), Complex.GetData());
+
+        float* Out = Magnitudes.GetData() + int64(Frame) * NumBins;
+        for (int32 k = 0; k < NumBins; ++k)
+        {
+            const float Re = Complex[2 * k];
+            const float Im = Complex[2 * k + 1];
+            Out[k] = FMath::Sqrt(Re * Re + Im * Im);
+        }
+    }
+    return true;
+}
+
+bool FOfflineSpectrogram::LoadOrCompute(const FString& ContentHash, const FMappedDecodedPcm& Pcm, int32 InFrameSize, int32 InHopSize)
+{
+    const FString Path = USongLibrarySubsystem::GetAnalysisCacheDir(ContentHash)
+        / FString::Printf(TEXT("spectrogram_%d_%d.bin"), InFrameSize, InHopSize);
+
+    if (Load(Path) && FrameSize == InFrameSize && HopSize == InHopSize)
+    {
+        return true;
+    }
+    if (!Compute(Pcm, InFrameSize, InHopSize))
+    {
+        return false;
+    }
+    Save(Path);
+    return true;
+}
+
+bool FOfflineSpectrogram::Load(const FString& Path)
+{
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+    if (!Reader)
+    {
+        return false;
+    }
+
+    uint32 FileMagic = 0;
+    int32 FileVersion = 0;
+    *Reader << FileMagic << FileVersion;
+    if (FileMagic != OfflineSpectrogram::Magic || FileVersion != OfflineSpectrogram::Version)
+    {
+        return false;
+    }
+
+    *Reader << FrameSize << HopSize << NumBins << NumFrames << SampleRate;
+    const int64 Count = int64(NumFrames) * NumBins;
+    if (Reader->IsError() || Count < 0 || Reader->TotalSize() - Reader->Tell() < Count * int64(sizeof(float)))
+    {
+        return false;
+    }
+    Magnitudes.SetNumUninitialized(Count);
+    Reader->Serialize(Magnitudes.GetData(), Count * sizeof(float));
+    return !Reader->IsError();
+}
+
+bool FOfflineSpectrogram::Save(const FString& Path) const
+{
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+    if (!Writer)
+    {
+        return false;
+    }
+
+    uint32 FileMagic = OfflineSpectrogram::Magic;
+    int32 FileVersion = OfflineSpectrogram::Version;
+    int32 OutFrameSize = FrameSize, OutHopSize = HopSize, OutNumBins = NumBins, OutNumFrames = NumFrames;
+    float OutSampleRate = SampleRate;
+    *Writer << FileMagic << FileVersion << OutFrameSize << OutHopSize << OutNumBins << OutNumFrames << OutSampleRate;
+    Writer->Serialize(const_cast<float*>(Magnitudes.GetData()), Magnitudes.Num() * sizeof(float));
+    return Writer->Close();
+}
+
+void FOfflineSpectrogram::DetectOnsets(TArray<int32>& OutFrames) const
+{
+    OutFrames.Reset();
+    if (NumFrames < 3)
+    {
+        return;
+    }
+
+    // Log-compressed magnitudes relative to the song maximum, so the detector is level independent.
+    float MaxMag = KINDA_SMALL_NUMBER;
+    for (const float M : Magnitudes)
+    {
+        MaxMag = FMath::Max(MaxMag, M);
+    }
+    const float Compress = 100.f / MaxMag;
+
+    TArray<float> Flux;
+    Flux.SetNumZeroed(NumFrames);
+    float MaxFlux = 0.f;
+    for (int32 t = 1; t < NumFrames; ++t)
+    {
+        const float* Cur = GetFrame(t);
+        const float* Prev = GetFrame(t - 1);
+        float Sum = 0.f;
+        for (int32 k = 0; k < NumBins; ++k)
+        {
+            Sum += FMath::Max(0.f, FMath::Loge(1.f + Compress * Cur[k]) - FMath::Loge(1.f + Compress * Prev[k]));
+        }
+        Flux[t] = Sum;
+        MaxFlux = FMath::Max(MaxFlux, Sum);
+    }
+
+    // Local maximum above a moving-average threshold, at most one onset per 100 ms.
+    const float FrameRate = GetFrameRate();
+    const int32 PeakRadius = FMath::Max(1, FMath::RoundToInt(0.03f * FrameRate));
+    const int32 MeanRadius = FMath::Max(2, FMath::RoundToInt(0.15f * FrameRate));
+    const int32 MinSpacing = FMath::Max(1, FMath::RoundToInt(0.1f * FrameRate));
+    const float Delta = 0.05f * MaxFlux;
+
+    int32 LastOnset = -MinSpacing;
+    for (int32 t = 1; t < NumFrames; ++t)
+    {
+        bool bIsPeak = true;
+        for (int32 j = FMath::Max(0, t - PeakRadius); j <= FMath::Min(NumFrames - 1, t + PeakRadius) && bIsPeak; ++j)
+        {
+            bIsPeak = Flux[j] <= Flux[t];
+        }
+        if (!bIsPeak || t - LastOnset < MinSpacing)
+        {
+            continue;
+        }
+
+        const int32 From = FMath::Max(0, t - MeanRadius);
+        const int32 To = FMath::Min(NumFrames - 1, t + MeanRadius);
+        float Mean = 0.f;
+        for (int32 j = From; j <= To; ++j)
+        {
+            Mean += Flux[j];
+        }
+        Mean /= float(To - From + 1);
+
+        if (Flux[t] > 1.5f * Mean + Delta)
+        {
+            OutFrames.Add(t);
+            LastOnset = t;
+        }
+    }
+}
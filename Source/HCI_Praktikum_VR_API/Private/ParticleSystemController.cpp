@@ -3,6 +3,7 @@
 #include "DrawDebugHelpers.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraDataInterfaceArrayFunctionLibrary.h"
+#include "ProximityGridSubsystem.h"
 
 // Sets default values
 AParticleSystemController::AParticleSystemController()
@@ -23,6 +24,13 @@ AParticleSystemController::AParticleSystemController()
 void AParticleSystemController::BeginPlay()
 {
     Super::BeginPlay();
+
+    // Grabbable emitters share one grid layer; cells sized to the largest grab radius
+    if (UProximityGridSubsystem* Proximity = UProximityGridSubsystem::Get(this))
+    {
+        Proximity->RequestLayerCellSize(GrabLayer, GrabRadius);
+        Proximity->RegisterComponent(GrabLayer, TargetNiagaraSystem);
+    }
 }
 
 // Called every frame
@@ -38,59 +46,67 @@ void AParticleSystemController::Tick(float DeltaTime)
 
 void AParticleSystemController::GrabParticleSystem()
 {
-    if (!TargetNiagaraSystem || bIsHoldingParticleSystem)
+    if (bIsHoldingParticleSystem || !MotionController)
         return;
 
-    // Get the distance between controller and particle system
-    float Distance = FVector::Distance(
-        MotionController->GetComponentLocation(),
-        TargetNiagaraSystem->GetComponentLocation()
-    );
+    const FVector HandLocation = MotionController->GetComponentLocation();
 
-    // Check if particle system is within grab radius
-    if (Distance <= GrabRadius)
+    // Nearest registered emitter within reach is held until release
+    UProximityGridSubsystem* Proximity = UProximityGridSubsystem::Get(this);
+    if (UNiagaraComponent* Nearest = Proximity ? Cast<UNiagaraComponent>(Proximity->FindNearest(GrabLayer, HandLocation, GrabRadius)) : nullptr)
+    {
+        GrabbedSystem = Nearest;
+    }
+    else if (TargetNiagaraSystem && FVector::Distance(HandLocation, TargetNiagaraSystem->GetComponentLocation()) <= GrabRadius)
     {
-        bIsHoldingParticleSystem = true;
-
-        // Calculate and store the offset
-        GrabOffset = TargetNiagaraSystem->GetComponentLocation() -
-            MotionController->GetComponentLocation();
-
-        // Optional: Visualize the grab
-        DrawDebugSphere(
-            GetWorld(),
-            TargetNiagaraSystem->GetComponentLocation(),
-            10.0f,
-            12,
-            FColor::Green,
-            false,
-            2.0f
-        );
+        GrabbedSystem = TargetNiagaraSystem;
     }
+    else
+    {
+        return;
+    }
+
+    bIsHoldingParticleSystem = true;
+
+    // Calculate and store the offset
+    GrabOffset = GrabbedSystem->GetComponentLocation() -
+        MotionController->GetComponentLocation();
+
+    // Optional: Visualize the grab
+    DrawDebugSphere(
+        GetWorld(),
+        GrabbedSystem->GetComponentLocation(),
+        10.0f,
+        12,
+        FColor::Green,
+        false,
+        2.0f
+    );
 }
 
 void AParticleSystemController::ReleaseParticleSystem()
 {
     bIsHoldingParticleSystem = false;
+    GrabbedSystem = nullptr;
 }
 
 void AParticleSystemController::UpdateParticleSystemPosition()
 {
-    if (!TargetNiagaraSystem || !bIsHoldingParticleSystem)
+    if (!GrabbedSystem || !bIsHoldingParticleSystem)
         return;
 
     // Update particle system position based on controller movement
     FVector NewLocation = MotionController->GetComponentLocation() + GrabOffset;
-    TargetNiagaraSystem->SetWorldLocation(NewLocation);
+    GrabbedSystem->SetWorldLocation(NewLocation);
 }
 
 void AParticleSystemController::ScaleParticleSystem(float ScaleFactor)
 {
-    if (!TargetNiagaraSystem || !bIsHoldingParticleSystem)
+    if (!GrabbedSystem || !bIsHoldingParticleSystem)
         return;
 
-    FVector CurrentScale = TargetNiagaraSystem->GetComponentScale();
-    TargetNiagaraSystem->SetWorldScale3D(CurrentScale * ScaleFactor);
+    FVector CurrentScale = GrabbedSystem->GetComponentScale();
+    GrabbedSystem->SetWorldScale3D(CurrentScale * ScaleFactor);
 }
 
 void AParticleSystemController::SetEmissionRate(float Rate)
@@ -0,0 +1,225 @@
+// PcmStreamSource.cpp
+
+#include "PcmStreamSource.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPcmStream, Log, All);
+
+FPcmStreamSource::FPcmStreamSource(int32 InPlaybackRingSamples, int32 InChunkFrames, int32 InAnalysisRingSamples)
+    : ChunkFrames(FMath::Max(256, InChunkFrames))
+    , PlaybackCapacity(uint32(FMath::Max(4096, InPlaybackRingSamples)))
+    , AnalysisCapacity(uint32(FMath::Max(1024, InAnalysisRingSamples)))
+{
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FPcmStreamSource::~FPcmStreamSource()
+{
+    Shutdown();
+    FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+    WakeEvent = nullptr;
+}
+
+bool FPcmStreamSource::Open(const FString& CachePath, const FString& ContentHash)
+{
+    Shutdown();
+
+    File.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*CachePath));
+    if (!File.IsValid()
+        || !File->Read(reinterpret_cast<uint8*>(&Header), sizeof(Header))
+        || !Header.IsValidFor(ContentHash, uint64(File->Size())))
+    {
+        UE_LOG(LogPcmStream, Warning, TEXT("Cannot stream %s: missing or invalid PCM cache."), *CachePath);
+        File.Reset();
+        Header = FDecodedPcmHeader();
+        return false;
+    }
+
+    TotalSamples = int64(Header.NumFrames * Header.NumChannels);
+    NextSample = 0;
+    SamplesPlayed = 0;
+    Underruns = 0;
+    bEndOfFile = false;
+    bStopRequested = false;
+
+    // SetCapacity also empties the rings.
+    PlaybackRing.SetCapacity(PlaybackCapacity);
+    AnalysisBuffer.SetNumZeroed(int32(AnalysisCapacity));
+    AnalysisReserved = 0;
+    AnalysisCommitted = 0;
+    AnalysisRead = 0;
+
+    const int32 ChunkSampleCount = ChunkFrames * int32(Header.NumChannels);
+    ChunkBytes.SetNumUninitialized(ChunkSampleCount * Header.GetBytesPerSample());
+    ChunkSamples.SetNumUninitialized(ChunkSampleCount);
+
+    // Prefill synchronously so playback does not start on an underrun.
+    while (PlaybackRing.Remainder() >= uint32(ChunkSampleCount) && ReadNextChunk())
+    {
+    }
+
+    Thread = FRunnableThread::Create(this, TEXT("PcmStreamSource"), 0, TPri_AboveNormal);
+    return Thread != nullptr;
+}
+
+void FPcmStreamSource::Shutdown()
+{
+    if (Thread)
+    {
+        Stop();
+        WakeEvent->Trigger();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+    File.Reset();
+}
+
+bool FPcmStreamSource::ReadNextChunk()
+{
+    const int64 Count = FMath::Min<int64>(ChunkSamples.Num(), TotalSamples - NextSample);
+    if (Count <= 0)
+    {
+        bEndOfFile = true;
+        return false;
+    }
+
+    if (!File->Read(ChunkBytes.GetData(), Count * Header.GetBytesPerSample()))
+    {
+        UE_LOG(LogPcmStream, Warning, TEXT("Read error at sample %lld, ending stream."), NextSample);
+        bEndOfFile = true;
+        return false;
+    }
+
+    if (Header.Format == uint8(EDecodedPcmFormat::Int16))
+    {
+        const int16* Src = reinterpret_cast<const int16*>(ChunkBytes.GetData());
+        constexpr float Scale = 1.0f / 32768.0f;
+        for (int64 i = 0; i < Count; ++i)
+        {
+            ChunkSamples[i] = Src[i] * Scale;
+        }
+        PlaybackRing.Push(ChunkSamples.GetData(), uint32(Count));
+    }
+    else
+    {
+        PlaybackRing.Push(reinterpret_cast<const float*>(ChunkBytes.GetData()), uint32(Count));
+    }
+
+    NextSample += Count;
+    return true;
+}
+
+uint32 FPcmStreamSource::Run()
+{
+    const uint32 ChunkSampleCount = uint32(ChunkSamples.Num());
+    while (!bStopRequested && !bEndOfFile)
+    {
+        if (PlaybackRing.Remainder() < ChunkSampleCount)
+        {
+            // Woken by the audio thread after each pop; the timeout only guards against missed wakes.
+            WakeEvent->Wait(10);
+            continue;
+        }
+        ReadNextChunk();
+    }
+    return 0;
+}
+
+void FPcmStreamSource::ReadPlayback(float* Out, int32 NumSamples)
+{
+    const int32 Popped = int32(PlaybackRing.Pop(Out, uint32(NumSamples)));
+    if (Popped < NumSamples)
+    {
+        FMemory::Memzero(Out + Popped, (NumSamples - Popped) * sizeof(float));
+        if (!bEndOfFile)
+        {
+            ++Underruns;
+        }
+    }
+
+    if (Popped > 0)
+    {
+        PushAnalysis(Out, Popped);
+        SamplesPlayed += Popped;
+        WakeEvent->Trigger();
+    }
+}
+
+void FPcmStreamSource::PushAnalysis(const float* Samples, int32 Num)
+{
+    // Never blocks on the consumer: if analysis is not drained in time the oldest samples are overwritten.
+    const uint64 Capacity = AnalysisCapacity;
+    const uint64 Start = AnalysisCommitted.load(std::memory_order_relaxed);
+    if (uint64(Num) > Capacity)
+    {
+        Samples += Num - int32(Capacity);
+        Num = int32(Capacity);
+    }
+
+    // Announce the slots about to be overwritten before touching them (seqlock-style)
+    AnalysisReserved.store(Start + Num, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const uint32 Offset = uint32(Start % Capacity);
+    const int32 First = FMath::Min(Num, int32(Capacity - Offset));
+    FMemory::Memcpy(AnalysisBuffer.GetData() + Offset, Samples, First * sizeof(float));
+    FMemory::Memcpy(AnalysisBuffer.GetData(), Samples + First, (Num - First) * sizeof(float));
+
+    AnalysisCommitted.store(Start + Num, std::memory_order_release);
+}
+
+int32 FPcmStreamSource::ReadAnalysis(float* Out, int32 MaxSamples)
+{
+    const uint64 Capacity = AnalysisCapacity;
+    for (;;)
+    {
+        const uint64 Committed = AnalysisCommitted.load(std::memory_order_acquire);
+        if (Committed - AnalysisRead > Capacity)
+        {
+            // Fell behind: skip what was overwritten and continue at the oldest sample still held
+            AnalysisRead = Committed - Capacity;
+        }
+        const int32 Num = int32(FMath::Min<uint64>(uint64(FMath::Max(0, MaxSamples)), Committed - AnalysisRead));
+        if (Num == 0)
+        {
+            return 0;
+        }
+
+        const uint32 Offset = uint32(AnalysisRead % Capacity);
+        const int32 First = FMath::Min(Num, int32(Capacity - Offset));
+        FMemory::Memcpy(Out, AnalysisBuffer.GetData() + Offset, First * sizeof(float));
+        FMemory::Memcpy(Out + First, AnalysisBuffer.GetData(), (Num - First) * sizeof(float));
+
+        // Samples the producer started overwriting during the copy are torn; drop them
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64 Reserved = AnalysisReserved.load(std::memory_order_relaxed);
+        const uint64 Oldest = Reserved > Capacity ? Reserved - Capacity : 0;
+        const int32 Torn = int32(FMath::Clamp<int64>(int64(Oldest) - int64(AnalysisRead), 0, Num));
+        AnalysisRead += Num;
+        if (Torn < Num)
+        {
+            if (Torn > 0)
+            {
+                FMemory::Memmove(Out, Out + Torn, (Num - Torn) * sizeof(float));
+            }
+            return Num - Torn;
+        }
+        // Everything copied was overwritten; retry from the new oldest sample
+    }
+}
+
+double FPcmStreamSource::GetPlaybackSeconds() const
+{
+    const int32 Channels = FMath::Max(1, GetNumChannels());
+    return Header.SampleRate ? double(SamplesPlayed.load() / Channels) / Header.SampleRate : 0.0;
+}
+
+SIZE_T FPcmStreamSource::GetAllocatedSize() const
+{
+    return (SIZE_T(PlaybackCapacity) + AnalysisCapacity) * sizeof(float)
+        + ChunkBytes.GetAllocatedSize() + ChunkSamples.GetAllocatedSize();
+}
@@ -0,0 +1,230 @@
+// ProximityBenchmark.cpp
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Components/SphereComponent.h"
+#include "Engine/OverlapResult.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "TimerManager.h"
+#include "SpatialHashGrid.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogProximityBenchmark, Log, All);
+
+/**
+ * Proximity.Benchmark [Counts=100,1000,10000] [Queries=1000] [Radius=30]
+ *
+ * For each count, spawns that many query-only spheres in a 20 m box away from
+ * the level, waits a frame so physics has them, then runs the same random hand
+ * positions through a sphere OverlapMulti and through the spatial hash grid
+ * (radius and 8-nearest). Also times moving every item once (the per-frame
+ * incremental update) and a full rebuild. Results go to the log and to
+ * Saved/StudyResults/ProximityBenchmark/.
+ */
+namespace ProximityBenchmark
+{
+    static const FVector Origin(0.0, 0.0, 100000.0);
+    static const FVector Extent(1000.0, 1000.0, 1000.0);
+    static constexpr int32 KNearest = 8;
+
+    struct FRunState
+    {
+        TWeakObjectPtr<UWorld> World;
+        TArray<int32> Counts;
+        int32 NumQueries = 1000;
+        float Radius = 30.0f;
+        int32 Step = 0;
+        TArray<TWeakObjectPtr<AActor>> Spawned;
+        TArray<FVector> Positions;
+        TArray<FString> CsvRows;
+    };
+
+    static void SpawnObjects(FRunState& State, UWorld* World, int32 Count)
+    {
+        FRandomStream Random(Count);
+        State.Positions.SetNumUninitialized(Count);
+        State.Spawned.Reset(Count);
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        for (int32 i = 0; i < Count; ++i)
+        {
+            const FVector P = Origin + FVector(Random.FRandRange(-1.0, 1.0), Random.FRandRange(-1.0, 1.0), Random.FRandRange(-1.0, 1.0)) * Extent;
+            State.Positions[i] = P;
+
+            AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(P), SpawnParams);
+            USphereComponent* Sphere = NewObject<USphereComponent>(Actor);
+            Sphere->SetSphereRadius(1.0f);
+            Sphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+            Sphere->SetCollisionObjectType(ECC_WorldDynamic);
+            Sphere->SetCollisionResponseToAllChannels(ECR_Overlap);
+            Sphere->SetGenerateOverlapEvents(false);
+            Actor->SetRootComponent(Sphere);
+            Sphere->RegisterComponent();
+            Sphere->SetWorldLocation(P);
+            State.Spawned.Add(Actor);
+        }
+    }
+
+    static void Measure(FRunState& State, UWorld* World, int32 Count)
+    {
+        FRandomStream Random(4711);
+        TArray<FVector> Hands;
+        Hands.SetNumUninitialized(State.NumQueries);
+        for (FVector& Hand : Hands)
+        {
+            Hand = Origin + FVector(Random.FRandRange(-1.0, 1.0), Random.FRandRange(-1.0, 1.0), Random.FRandRange(-1.0, 1.0)) * Extent;
+        }
+
+        // Physics overlaps
+        TArray<FOverlapResult> Overlaps;
+        const FCollisionObjectQueryParams ObjectParams(ECC_WorldDynamic);
+        const FCollisionShape Shape = FCollisionShape::MakeSphere(State.Radius);
+        int64 OverlapHits = 0;
+        uint64 Start = FPlatformTime::Cycles64();
+        for (const FVector& Hand : Hands)
+        {
+            Overlaps.Reset();
+            World->OverlapMultiByObjectType(Overlaps, Hand, FQuat::Identity, ObjectParams, Shape);
+            OverlapHits += Overlaps.Num();
+        }
+        const double OverlapMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start);
+
+        // Grid, cell size = query radius
+        FSpatialHashGrid Grid(State.Radius);
+        Start = FPlatformTime::Cycles64();
+        Grid.Rebuild(State.Positions);
+        const double RebuildMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start);
+
+        TArray<int32> Ids;
+        int64 GridHits = 0;
+        Start = FPlatformTime::Cycles64();
+        for (const FVector& Hand : Hands)
+        {
+            Grid.QueryRadius(Hand, State.Radius, Ids);
+            GridHits += Ids.Num();
+        }
+        const double RadiusMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start);
+
+        Start = FPlatformTime::Cycles64();
+        for (const FVector& Hand : Hands)
+        {
+            Grid.QueryKNearest(Hand, KNearest, 4.0f * State.Radius, Ids);
+        }
+        const double KNearestMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start);
+
+        // One frame of drift for every item
+        Start = FPlatformTime::Cycles64();
+        for (int32 Id = 0; Id < State.Positions.Num(); ++Id)
+        {
+            Grid.Move(Id, State.Positions[Id] + FVector(2.0, -1.5, 0.5));
+        }
+        const double MoveMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start);
+
+        const double PerQuery = 1000.0 / State.NumQueries; // ms total -> us per query
+        UE_LOG(LogProximityBenchmark, Display, TEXT("%d objects, %d queries, radius %.0f:"), Count, State.NumQueries, State.Radius);
+        UE_LOG(LogProximityBenchmark, Display, TEXT("  Overlap sphere:   %.2f us/query (%lld hits)"), OverlapMs * PerQuery, OverlapHits);
+        UE_LOG(LogProximityBenchmark, Display, TEXT("  Grid radius:      %.2f us/query (%lld hits)"), RadiusMs * PerQuery, GridHits);
+        UE_LOG(LogProximityBenchmark, Display, TEXT("  Grid %d-nearest:   %.2f us/query"), KNearest, KNearestMs * PerQuery);
+        UE_LOG(LogProximityBenchmark, Display, TEXT("  Grid update:      %.3f ms move-all, %.3f ms rebuild"), MoveMs, RebuildMs);
+
+        State.CsvRows.Add(FString::Printf(TEXT("%d,%d,%.1f,%.4f,%.4f,%.4f,%.4f,%.4f,%lld,%lld"),
+            Count, State.NumQueries, State.Radius, OverlapMs * PerQuery, RadiusMs * PerQuery, KNearestMs * PerQuery,
+            MoveMs, RebuildMs, OverlapHits, GridHits));
+    }
+
+    static void Cleanup(FRunState& State)
+    {
+        for (const TWeakObjectPtr<AActor>& Actor : State.Spawned)
+        {
+            if (Actor.IsValid())
+            {
+                Actor->Destroy();
+            }
+        }
+        State.Spawned.Reset();
+    }
+
+    static void WriteCsv(const FRunState& State)
+    {
+        const FString Dir = FPaths::ProjectSavedDir() + TEXT("StudyResults/ProximityBenchmark/");
+        const FString FileName = Dir + FDateTime::UtcNow().ToString(TEXT("%Y-%m-%d_%H-%M-%S")) + TEXT(".csv");
+        FString Csv = TEXT("Objects,Queries,Radius,OverlapUsPerQuery,GridRadiusUsPerQuery,GridKNearestUsPerQuery,GridMoveAllMs,GridRebuildMs,OverlapHits,GridHits\n");
+        for (const FString& Row : State.CsvRows)
+        {
+            Csv += Row + TEXT("\n");
+        }
+        if (FFileHelper::SaveStringToFile(Csv, *FileName))
+        {
+            UE_LOG(LogProximityBenchmark, Display, TEXT("Wrote %s"), *FileName);
+        }
+    }
+
+    static void RunStep(TSharedRef<FRunState> State)
+    {
+        UWorld* World = State->World.Get();
+        if (!World)
+        {
+            return;
+        }
+        if (!State->Counts.IsValidIndex(State->Step))
+        {
+            WriteCsv(*State);
+            return;
+        }
+
+        const int32 Count = State->Counts[State->Step];
+        SpawnObjects(*State, World, Count);
+
+        // Measure once physics has the new bodies in its query structure
+        World->GetTimerManager().SetTimerForNextTick([State, Count]()
+        {
+            if (UWorld* World = State->World.Get())
+            {
+                Measure(*State, World, Count);
+            }
+            Cleanup(*State);
+            ++State->Step;
+            RunStep(State);
+        });
+    }
+
+    static void Run(const TArray<FString>& Args, UWorld* World)
+    {
+        if (!World || !World->IsGameWorld())
+        {
+            UE_LOG(LogProximityBenchmark, Error, TEXT("Proximity.Benchmark needs a game world (PIE or standalone)."));
+            return;
+        }
+
+        TSharedRef<FRunState> State = MakeShared<FRunState>();
+        State->World = World;
+        if (Args.Num() > 0)
+        {
+            TArray<FString> Parts;
+            Args[0].ParseIntoArray(Parts, TEXT(","));
+            for (const FString& Part : Parts)
+            {
+                State->Counts.Add(FMath::Clamp(FCString::Atoi(*Part), 1, 100000));
+            }
+        }
+        if (State->Counts.Num() == 0)
+        {
+            State->Counts = { 100, 1000, 10000 };
+        }
+        State->NumQueries = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 1000;
+        State->Radius = Args.Num() > 2 ? FMath::Max(1.0f, FCString::Atof(*Args[2])) : 30.0f;
+
+        RunStep(State);
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs BenchmarkCommand(
+        TEXT("Proximity.Benchmark"),
+        TEXT("Compare physics sphere overlaps with the spatial hash grid. Args: [Counts=100,1000,10000] [Queries=1000] [Radius=30]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&Run));
+}
@@ -0,0 +1,204 @@
+// ProximityGridSubsystem.cpp
+
+#include "ProximityGridSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+UProximityGridSubsystem* UProximityGridSubsystem::Get(const UObject* WorldContextObject)
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UProximityGridSubsystem>() : nullptr;
+}
+
+void UProximityGridSubsystem::Deinitialize()
+{
+    Layers.Empty();
+    Super::Deinitialize();
+}
+
+TStatId UProximityGridSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UProximityGridSubsystem, STATGROUP_Tickables);
+}
+
+UProximityGridSubsystem::FLayer& UProximityGridSubsystem::GetLayer(FName Layer)
+{
+    return Layers.FindOrAdd(Layer);
+}
+
+void UProximityGridSubsystem::RemoveId(FLayer& Layer, int32 Id)
+{
+    Layer.Grid.Remove(Id);
+    Layer.Ids.Remove(Layer.Keys[Id]);
+    Layer.Components[Id].Reset();
+    Layer.Keys[Id] = TObjectKey<USceneComponent>();
+}
+
+void UProximityGridSubsystem::Tick(float DeltaTime)
+{
+    for (TPair<FName, FLayer>& Pair : Layers)
+    {
+        FLayer& Layer = Pair.Value;
+        for (int32 Id = 0; Id < Layer.Components.Num(); ++Id)
+        {
+            if (!Layer.Grid.IsValidId(Id))
+            {
+                continue;
+            }
+            const USceneComponent* Component = Layer.Components[Id].Get();
+            if (!Component)
+            {
+                // Destroyed without unregistering
+                RemoveId(Layer, Id);
+                continue;
+            }
+            const FVector Location = Component->GetComponentLocation();
+            if (!Location.Equals(Layer.Grid.GetPosition(Id), KINDA_SMALL_NUMBER))
+            {
+                Layer.Grid.Move(Id, Location);
+            }
+        }
+    }
+}
+
+void UProximityGridSubsystem::SetLayerCellSize(FName Layer, float CellSize)
+{
+    FLayer& L = GetLayer(Layer);
+    L.Grid.SetCellSize(CellSize);
+    L.RequestedCellSize = CellSize;
+}
+
+void UProximityGridSubsystem::RequestLayerCellSize(FName Layer, float QueryRadius)
+{
+    FLayer& L = GetLayer(Layer);
+    if (QueryRadius > L.RequestedCellSize)
+    {
+        L.RequestedCellSize = QueryRadius;
+        L.Grid.SetCellSize(QueryRadius);
+    }
+}
+
+void UProximityGridSubsystem::RegisterComponent(FName Layer, USceneComponent* Component)
+{
+    if (!IsValid(Component))
+    {
+        return;
+    }
+    FLayer& L = GetLayer(Layer);
+    if (L.Ids.Contains(Component))
+    {
+        return;
+    }
+    const int32 Id = L.Grid.Add(Component->GetComponentLocation());
+    if (L.Components.Num() <= Id)
+    {
+        L.Components.SetNum(Id + 1);
+        L.Keys.SetNum(Id + 1);
+    }
+    L.Components[Id] = Component;
+    L.Keys[Id] = Component;
+    L.Ids.Add(Component, Id);
+}
+
+void UProximityGridSubsystem::RegisterActor(FName Layer, AActor* Actor)
+{
+    if (IsValid(Actor))
+    {
+        RegisterComponent(Layer, Actor->GetRootComponent());
+    }
+}
+
+void UProximityGridSubsystem::UnregisterComponent(FName Layer, USceneComponent* Component)
+{
+    FLayer* L = Layers.Find(Layer);
+    const int32* Id = L ? L->Ids.Find(Component) : nullptr;
+    if (Id)
+    {
+        RemoveId(*L, *Id);
+    }
+}
+
+TArray<USceneComponent*> UProximityGridSubsystem::FindInRadius(FName Layer, FVector Location, float Radius) const
+{
+    TArray<USceneComponent*> Result;
+    const FLayer* L = Layers.Find(Layer);
+    if (!L)
+    {
+        return Result;
+    }
+    TArray<int32> Ids;
+    L->Grid.QueryRadius(Location, Radius, Ids);
+    Result.Reserve(Ids.Num());
+    for (const int32 Id : Ids)
+    {
+        if (USceneComponent* Component = L->Components[Id].Get())
+        {
+            Result.Add(Component);
+        }
+    }
+    return Result;
+}
+
+TArray<AActor*> UProximityGridSubsystem::FindActorsInRadius(FName Layer, FVector Location, float Radius) const
+{
+    TArray<AActor*> Result;
+    for (const USceneComponent* Component : FindInRadius(Layer, Location, Radius))
+    {
+        if (AActor* Owner = Component->GetOwner())
+        {
+            Result.AddUnique(Owner);
+        }
+    }
+    return Result;
+}
+
+USceneComponent* UProximityGridSubsystem::FindNearest(FName Layer, FVector Location, float MaxRadius) const
+{
+    const FLayer* L = Layers.Find(Layer);
+    if (!L)
+    {
+        return nullptr;
+    }
+    const int32 Id = L->Grid.FindNearest(Location, MaxRadius);
+    return Id != INDEX_NONE ? L->Components[Id].Get() : nullptr;
+}
+
+TArray<USceneComponent*> UProximityGridSubsystem::FindKNearest(FName Layer, FVector Location, int32 K, float MaxRadius) const
+{
+    TArray<USceneComponent*> Result;
+    const FLayer* L = Layers.Find(Layer);
+    if (!L)
+    {
+        return Result;
+    }
+    TArray<int32> Ids;
+    L->Grid.QueryKNearest(Location, K, MaxRadius, Ids);
+    Result.Reserve(Ids.Num());
+    for (const int32 Id : Ids)
+    {
+        if (USceneComponent* Component = L->Components[Id].Get())
+        {
+            Result.Add(Component);
+        }
+    }
+    return Result;
+}
+
+int32 UProximityGridSubsystem::GetLayerNum(FName Layer) const
+{
+    const FLayer* L = Layers.Find(Layer);
+    return L ? L->Grid.Num() : 0;
+}
+
+const FSpatialHashGrid* UProximityGridSubsystem::GetGrid(FName Layer) const
+{
+    const FLayer* L = Layers.Find(Layer);
+    return L ? &L->Grid : nullptr;
+}
+
+USceneComponent* UProximityGridSubsystem::GetComponent(FName Layer, int32 Id) const
+{
+    const FLayer* L = Layers.Find(Layer);
+    return L && L->Components.IsValidIndex(Id) ? L->Components[Id].Get() : nullptr;
+}
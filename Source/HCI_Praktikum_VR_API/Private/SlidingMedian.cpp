@@ -0,0 +1,196 @@
+// SlidingMedian.cpp
+
+#include "SlidingMedian.h"
+
+/**
+ * Heap operations on one channel. Positions are signed: 0 is the median,
+ * 1..HalfCount the min-heap of the upper half (root at 1), -1..-HalfCount the
+ * max-heap of the lower half (root at -1). Children of p are 2p and 2p+1
+ * (or 2p and 2p-1 on the negative side), so the same index arithmetic walks
+ * both heaps.
+ */
+struct FSlidingMedianBank::FChannelView
+{
+    float* Values;
+    int32* SlotPos;
+    int32* Heap;     // already offset so Heap[0] is the median entry
+    int32 HalfCount;
+
+    FORCEINLINE bool Less(int32 A, int32 B) const
+    {
+        return Values[Heap[A]] < Values[Heap[B]];
+    }
+
+    FORCEINLINE void Exchange(int32 A, int32 B)
+    {
+        const int32 T = Heap[A];
+        Heap[A] = Heap[B];
+        Heap[B] = T;
+        SlotPos[Heap[A]] = A;
+        SlotPos[Heap[B]] = B;
+    }
+
+    /** Swap A and B if A < B; returns whether it swapped. */
+    FORCEINLINE bool CompareExchange(int32 A, int32 B)
+    {
+        if (Less(A, B))
+        {
+            Exchange(A, B);
+            return true;
+        }
+        return false;
+    }
+
+    void MinSortDown(int32 Child)
+    {
+        for (; Child <= HalfCount; Child *= 2)
+        {
+            if (Child > 1 && Child < HalfCount && Less(Child + 1, Child))
+            {
+                ++Child;
+            }
+            if (!CompareExchange(Child, Child / 2))
+            {
+                break;
+            }
+        }
+    }
+
+    void MaxSortDown(int32 Child)
+    {
+        for (; Child >= -HalfCount; Child *= 2)
+        {
+            if (Child < -1 && Child > -HalfCount && Less(Child, Child - 1))
+            {
+                --Child;
+            }
+            if (!CompareExchange(Child / 2, Child))
+            {
+                break;
+            }
+        }
+    }
+
+    /** Returns true if the entry reached the median position. */
+    bool MinSortUp(int32 Pos)
+    {
+        while (Pos > 0 && CompareExchange(Pos, Pos / 2))
+        {
+            Pos /= 2;
+        }
+        return Pos == 0;
+    }
+
+    bool MaxSortUp(int32 Pos)
+    {
+        while (Pos < 0 && CompareExchange(Pos / 2, Pos))
+        {
+            Pos /= 2;
+        }
+        return Pos == 0;
+    }
+};
+
+FSlidingMedianBank::FChannelView FSlidingMedianBank::MakeView(int32 Channel)
+{
+    const int32 Base = Channel * WindowSize;
+    return FChannelView{ Values.GetData() + Base, SlotPos.GetData() + Base, Heap.GetData() + Base + HalfCount, HalfCount };
+}
+
+void FSlidingMedianBank::Init(int32 InNumChannels, int32 InWindowSize, float FillValue)
+{
+    NumChannels = FMath::Max(0, InNumChannels);
+    WindowSize = FMath::Max(1, InWindowSize) | 1;
+    HalfCount = WindowSize / 2;
+
+    const int32 Total = NumChannels * WindowSize;
+    Values.SetNumUninitialized(Total);
+    SlotPos.SetNumUninitialized(Total);
+    Heap.SetNumUninitialized(Total);
+    NextSlot.SetNumUninitialized(NumChannels);
+
+    Reset(FillValue);
+}
+
+void FSlidingMedianBank::Reset(float FillValue)
+{
+    for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+    {
+        ResetChannel(Channel, FillValue);
+    }
+}
+
+void FSlidingMedianBank::ResetChannel(int32 Channel, float FillValue)
+{
+    FChannelView View = MakeView(Channel);
+    for (int32 Slot = 0; Slot < WindowSize; ++Slot)
+    {
+        // Alternate slots between the two heaps: 0, -1, 1, -2, 2, ...
+        const int32 Pos = ((Slot + 1) / 2) * ((Slot & 1) ? -1 : 1);
+        View.Values[Slot] = FillValue;
+        View.SlotPos[Slot] = Pos;
+        View.Heap[Pos] = Slot;
+    }
+    NextSlot[Channel] = 0;
+}
+
+float FSlidingMedianBank::Push(int32 Channel, float Value)
+{
+    FChannelView View = MakeView(Channel);
+
+    int32& Slot = NextSlot[Channel];
+    const int32 Pos = View.SlotPos[Slot];
+    const float Old = View.Values[Slot];
+    View.Values[Slot] = Value;
+    Slot = (Slot + 1 == WindowSize) ? 0 : Slot + 1;
+
+    if (Pos > 0)
+    {
+        // Replaced an entry of the upper half.
+        if (Old < Value)
+        {
+            View.MinSortDown(Pos * 2);
+        }
+        else if (View.MinSortUp(Pos))
+        {
+            View.MaxSortDown(-1);
+        }
+    }
+    else if (Pos < 0)
+    {
+        // Replaced an entry of the lower half.
+        if (Value < Old)
+        {
+            View.MaxSortDown(Pos * 2);
+        }
+        else if (View.MaxSortUp(Pos))
+        {
+            View.MinSortDown(1);
+        }
+    }
+    else
+    {
+        // Replaced the median itself.
+        if (HalfCount > 0)
+        {
+            View.MaxSortDown(-1);
+            View.MinSortDown(1);
+        }
+    }
+
+    return View.Values[View.Heap[0]];
+}
+
+void FSlidingMedianBank::PushAll(const float* InValues, float* OutMedians)
+{
+    for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+    {
+        OutMedians[Channel] = Push(Channel, InValues[Channel]);
+    }
+}
+
+float FSlidingMedianBank::GetMedian(int32 Channel) const
+{
+    const int32 Base = Channel * WindowSize;
+    return Values[Base + Heap[Base + HalfCount]];
+}
@@ -0,0 +1,38 @@
+// SlidingMedianSmoother.cpp
+
+#include "SlidingMedianSmoother.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSlidingMedianSmoother, Log, All);
+
+USlidingMedianSmoother* USlidingMedianSmoother::CreateSlidingMedianSmoother(int32 WindowSize, int32 NumBands)
+{
+    USlidingMedianSmoother* Smoother = NewObject<USlidingMedianSmoother>();
+    Smoother->Bank.Init(FMath::Max(1, NumBands), WindowSize);
+    return Smoother;
+}
+
+float USlidingMedianSmoother::Update(float NewSample)
+{
+    return Bank.Push(0, NewSample);
+}
+
+void USlidingMedianSmoother::UpdateBands(const TArray<float>& NewSamples, TArray<float>& OutMedians)
+{
+    const int32 NumBands = Bank.GetNumChannels();
+    if (NewSamples.Num() != NumBands)
+    {
+        UE_LOG(LogSlidingMedianSmoother, Warning, TEXT("UpdateBands: got %d samples for %d bands."), NewSamples.Num(), NumBands);
+        return;
+    }
+
+    if (&OutMedians != &NewSamples)
+    {
+        OutMedians.SetNumUninitialized(NumBands);
+    }
+    Bank.PushAll(NewSamples.GetData(), OutMedians.GetData());
+}
+
+float USlidingMedianSmoother::GetMedian(int32 Band) const
+{
+    return (Band >= 0 && Band < Bank.GetNumChannels()) ? Bank.GetMedian(Band) : 0.f;
+}
@@ -0,0 +1,375 @@
+// SongLibrarySubsystem.cpp
+
+#include "SongLibrarySubsystem.h"
+#include "DecodedPcmCache.h"
+#include "LoudnessMeter.h"
+#include "RuntimeAudioImporterLibrary.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSongLibrary, Log, All);
+
+namespace SongLibrary
+{
+    static const TCHAR* const SupportedExtensions[] = { TEXT("mp3"), TEXT("wav"), TEXT("ogg"), TEXT("flac") };
+
+    static bool IsSupportedAudioFile(const FString& Path)
+    {
+        const FString Ext = FPaths::GetExtension(Path);
+        for (const TCHAR* Supported : SupportedExtensions)
+        {
+            if (Ext.Equals(Supported, ESearchCase::IgnoreCase))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static FString HashBuffer(const uint8* Data, int64 Size)
+    {
+        const FXxHash64 Hash = FXxHash64::HashBuffer(Data, Size);
+        return FString::Printf(TEXT("%016llx"), Hash.Hash);
+    }
+}
+
+void USongLibrarySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    LoadIndex();
+    // Picking up new or edited songs is cheap when nothing changed (stat only), so always refresh.
+    RebuildIndexAsync(false);
+}
+
+void USongLibrarySubsystem::Deinitialize()
+{
+    if (IndexingTask.IsValid())
+    {
+        IndexingTask.Wait();
+    }
+    Super::Deinitialize();
+}
+
+FString USongLibrarySubsystem::GetIndexFilePath() const
+{
+    return FPaths::ProjectSavedDir() / TEXT("SongLibrary") / TEXT("SongIndex.json");
+}
+
+FString USongLibrarySubsystem::GetResolvedMusicFolder() const
+{
+    if (FPaths::IsRelative(MusicFolder))
+    {
+        return FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / MusicFolder);
+    }
+    return MusicFolder;
+}
+
+FString USongLibrarySubsystem::GetAnalysisCacheDir(const FString& ContentHash)
+{
+    return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("SongLibrary") / TEXT("Cache") / ContentHash);
+}
+
+FString USongLibrarySubsystem::HashFileContents(const FString& FilePath)
+{
+    TArray64<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+    {
+        return FString();
+    }
+    return HashBuffer(Bytes.GetData(), Bytes.Num());
+}
+
+FString USongLibrarySubsystem::HashBuffer(const uint8* Data, int64 Size)
+{
+    return SongLibrary::HashBuffer(Data, Size);
+}
+
+void USongLibrarySubsystem::SetMusicFolder(const FString& InFolder)
+{
+    if (MusicFolder != InFolder)
+    {
+        MusicFolder = InFolder;
+        RebuildIndexAsync(false);
+    }
+}
+
+void USongLibrarySubsystem::LoadIndex()
+{
+    FString Json;
+    if (!FFileHelper::LoadFileToString(Json, *GetIndexFilePath()))
+    {
+        return;
+    }
+
+    FSongLibraryIndexFile IndexFile;
+    if (!FJsonObjectConverter::JsonObjectStringToUStruct(Json, &IndexFile, 0, 0) || IndexFile.Version != IndexVersion)
+    {
+        UE_LOG(LogSongLibrary, Warning, TEXT("Ignoring outdated or unreadable song index %s"), *GetIndexFilePath());
+        return;
+    }
+
+    Songs = MoveTemp(IndexFile.Songs);
+    RebuildLookups();
+    UE_LOG(LogSongLibrary, Log, TEXT("Loaded song index with %d songs."), Songs.Num());
+}
+
+void USongLibrarySubsystem::SaveIndex() const
+{
+    FSongLibraryIndexFile IndexFile;
+    IndexFile.Version = IndexVersion;
+    IndexFile.Songs = Songs;
+
+    FString Json;
+    if (!FJsonObjectConverter::UStructToJsonObjectString(IndexFile, Json) || !FFileHelper::SaveStringToFile(Json, *GetIndexFilePath()))
+    {
+        UE_LOG(LogSongLibrary, Error, TEXT("Failed to write song index to %s"), *GetIndexFilePath());
+    }
+}
+
+void USongLibrarySubsystem::RebuildLookups()
+{
+    SongsByPath.Reset();
+    SongsByName.Reset();
+    for (int32 i = 0; i < Songs.Num(); ++i)
+    {
+        SongsByPath.Add(Songs[i].FilePath.ToLower(), i);
+        SongsByName.Add(Songs[i].FileName.ToLower(), i);
+        SongsByName.Add(FPaths::GetBaseFilename(Songs[i].FileName).ToLower(), i);
+    }
+}
+
+bool USongLibrarySubsystem::FindSong(const FString& NameOrPath, FSongLibraryEntry& OutEntry) const
+{
+    const FString Key = NameOrPath.ToLower();
+    const int32* Index = SongsByName.Find(Key);
+    if (!Index)
+    {
+        Index = SongsByPath.Find(FPaths::ConvertRelativePathToFull(NameOrPath).ToLower());
+    }
+    if (!Index)
+    {
+        return false;
+    }
+    OutEntry = Songs[*Index];
+    return true;
+}
+
+bool USongLibrarySubsystem::GetNewestSong(FSongLibraryEntry& OutEntry) const
+{
+    const FSongLibraryEntry* Newest = nullptr;
+    for (const FSongLibraryEntry& Entry : Songs)
+    {
+        if (!Newest || Entry.ModifiedTime > Newest->ModifiedTime)
+        {
+            Newest = &Entry;
+        }
+    }
+    if (!Newest)
+    {
+        return false;
+    }
+    OutEntry = *Newest;
+    return true;
+}
+
+void USongLibrarySubsystem::RebuildIndexAsync(bool bForceReprocess)
+{
+    bool bExpected = false;
+    if (!bIsIndexing.compare_exchange_strong(bExpected, true))
+    {
+        // The running task scans with the old settings; run again once it has been applied.
+        UE_LOG(LogSongLibrary, Verbose, TEXT("RebuildIndexAsync: indexing in progress, queued another pass."));
+        bRebuildPending = true;
+        bPendingForceReprocess |= bForceReprocess;
+        return;
+    }
+
+    const FString Folder = GetResolvedMusicFolder();
+    const float Target = TargetLufs;
+    const bool bWritePcm = bWriteDecodedPcmCache;
+    TWeakObjectPtr<USongLibrarySubsystem> WeakThis(this);
+
+    IndexingTask = Async(EAsyncExecution::ThreadPool, [WeakThis, Folder, Target, bWritePcm, Previous = Songs, bForceReprocess]()
+        {
+            TArray<FSongLibraryEntry> NewSongs = BuildIndex(Folder, Previous, Target, bWritePcm, bForceReprocess);
+
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, NewSongs = MoveTemp(NewSongs)]() mutable
+                {
+                    if (USongLibrarySubsystem* Self = WeakThis.Get())
+                    {
+                        Self->ApplyIndex(MoveTemp(NewSongs));
+                    }
+                });
+        });
+}
+
+void USongLibrarySubsystem::RebuildIndex(bool bForceReprocess)
+{
+    bool bExpected = false;
+    if (!bIsIndexing.compare_exchange_strong(bExpected, true))
+    {
+        // An async rebuild is already running; queue a pass that starts when it has been applied.
+        bRebuildPending = true;
+        bPendingForceReprocess |= bForceReprocess;
+        return;
+    }
+    ApplyIndex(BuildIndex(GetResolvedMusicFolder(), Songs, TargetLufs, bWriteDecodedPcmCache, bForceReprocess));
+}
+
+void USongLibrarySubsystem::ApplyIndex(TArray<FSongLibraryEntry>&& NewSongs)
+{
+    Songs = MoveTemp(NewSongs);
+    RebuildLookups();
+    SaveIndex();
+    bIsIndexing = false;
+
+    if (bRebuildPending)
+    {
+        // Settings changed while indexing (e.g. SetMusicFolder at BeginPlay); this result is already stale.
+        const bool bForce = bPendingForceReprocess;
+        bRebuildPending = false;
+        bPendingForceReprocess = false;
+        RebuildIndexAsync(bForce);
+        return;
+    }
+    OnLibraryIndexed.Broadcast(Songs.Num());
+}
+
+TArray<FSongLibraryEntry> USongLibrarySubsystem::BuildIndex(const FString& Folder, const TArray<FSongLibraryEntry>& Previous, float InTargetLufs, bool bWritePcmCache, bool bForceReprocess)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    TMap<FString, const FSongLibraryEntry*> PreviousByPath;
+    for (const FSongLibraryEntry& Entry : Previous)
+    {
+        PreviousByPath.Add(Entry.FilePath.ToLower(), &Entry);
+    }
+
+    TArray<FSongLibraryEntry> Result;
+    TArray<int32> Dirty;
+
+    IFileManager::Get().IterateDirectoryStat(*Folder, [&](const TCHAR* Path, const FFileStatData& Stat)
+        {
+            if (Stat.bIsDirectory || !SongLibrary::IsSupportedAudioFile(Path))
+            {
+                return true;
+            }
+
+            const FString FullPath = FPaths::ConvertRelativePathToFull(Path);
+            const FSongLibraryEntry* const* Prev = PreviousByPath.Find(FullPath.ToLower());
+
+            FSongLibraryEntry& Entry = Result.Emplace_GetRef();
+            if (Prev)
+            {
+                Entry = **Prev;
+            }
+            Entry.FilePath = FullPath;
+            Entry.FileName = FPaths::GetCleanFilename(FullPath);
+
+            const bool bUnchanged = Prev && (*Prev)->FileSize == Stat.FileSize && (*Prev)->ModifiedTime == Stat.ModificationTime;
+            if (!bUnchanged || bForceReprocess)
+            {
+                Entry.FileSize = Stat.FileSize;
+                Entry.ModifiedTime = Stat.ModificationTime;
+                if (bForceReprocess)
+                {
+                    Entry.ContentHash.Reset();
+                }
+                Dirty.Add(Result.Num() - 1);
+            }
+            return true;
+        });
+
+    TArray<bool> Succeeded;
+    Succeeded.Init(true, Result.Num());
+
+    ParallelFor(Dirty.Num(), [&](int32 WorkIndex)
+        {
+            const int32 EntryIndex = Dirty[WorkIndex];
+            Succeeded[EntryIndex] = ProcessFile(Result[EntryIndex].FilePath, InTargetLufs, bWritePcmCache, Result[EntryIndex]);
+        });
+
+    for (int32 i = Result.Num() - 1; i >= 0; --i)
+    {
+        if (!Succeeded[i])
+        {
+            Result.RemoveAt(i);
+        }
+    }
+
+    UE_LOG(LogSongLibrary, Log, TEXT("Indexed %d songs in %s (%d reprocessed) in %.2f s."),
+        Result.Num(), *Folder, Dirty.Num(), FPlatformTime::Seconds() - StartTime);
+    return Result;
+}
+
+bool USongLibrarySubsystem::ProcessFile(const FString& FilePath, float InTargetLufs, bool bWritePcmCache, FSongLibraryEntry& InOutEntry)
+{
+    TArray64<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+    {
+        UE_LOG(LogSongLibrary, Warning, TEXT("Could not read %s"), *FilePath);
+        return false;
+    }
+
+    const FString Hash = SongLibrary::HashBuffer(Bytes.GetData(), Bytes.Num());
+    if (Hash == InOutEntry.ContentHash && InOutEntry.SampleRate > 0)
+    {
+        // Touched but not modified: keep the existing analysis.
+        return true;
+    }
+
+    FDecodedAudioStruct Decoded;
+    const ERuntimeAudioFormat Format = URuntimeAudioImporterLibrary::GetAudioFormat(FilePath);
+    if (!URuntimeAudioImporterLibrary::DecodeAudioData(FEncodedAudioStruct(MoveTemp(Bytes), Format), Decoded))
+    {
+        UE_LOG(LogSongLibrary, Warning, TEXT("Could not decode %s"), *FilePath);
+        return false;
+    }
+
+    InOutEntry.ContentHash = Hash;
+    InOutEntry.SampleRate = Decoded.SoundWaveBasicInfo.SampleRate;
+    InOutEntry.NumChannels = Decoded.SoundWaveBasicInfo.NumOfChannels;
+    InOutEntry.DurationSeconds = Decoded.SoundWaveBasicInfo.Duration;
+    InOutEntry.AnalysisCacheDir = GetAnalysisCacheDir(Hash);
+
+    const TArrayView64<float> Pcm = Decoded.PCMInfo.PCMData.GetView();
+
+    // We already paid for the decode, so leave it on disk for the next condition start.
+    if (bWritePcmCache && !FDecodedPcmCache::Exists(Hash))
+    {
+        FDecodedPcmCache::Write(Hash, Pcm, InOutEntry.SampleRate, InOutEntry.NumChannels, EDecodedPcmFormat::Int16);
+    }
+    float Peak = 0.0f;
+    double SumSquares = 0.0;
+    for (const float Sample : Pcm)
+    {
+        Peak = FMath::Max(Peak, FMath::Abs(Sample));
+        SumSquares += double(Sample) * Sample;
+    }
+
+    FSongNormalizationProfile& Norm = InOutEntry.Normalization;
+    Norm.PeakAmplitude = Peak;
+    const double MeanSquare = Pcm.Num() > 0 ? SumSquares / double(Pcm.Num()) : 0.0;
+    Norm.RmsDb = MeanSquare > 1e-12 ? float(10.0 * FMath::LogX(10.0, MeanSquare)) : -120.0f;
+
+    if (InOutEntry.NumChannels > 0 && InOutEntry.NumChannels <= FLoudnessMeter::MaxChannels)
+    {
+        FLoudnessMeter Meter;
+        Meter.Init(float(InOutEntry.SampleRate), InOutEntry.NumChannels);
+        Meter.Process(Pcm.GetData(), int32(Pcm.Num() / InOutEntry.NumChannels));
+        Norm.IntegratedLufs = Meter.GetIntegratedLufs();
+    }
+
+    const float Level = Norm.IntegratedLufs > FLoudnessMeter::SilenceLufs ? Norm.IntegratedLufs : Norm.RmsDb;
+    const float GainToTarget = FMath::Pow(10.0f, (InTargetLufs - Level) / 20.0f);
+    Norm.SuggestedGain = Peak > KINDA_SMALL_NUMBER ? FMath::Min(GainToTarget, 1.0f / Peak) : 1.0f;
+
+    return true;
+}
@@ -0,0 +1,336 @@
+// SpatialHashGrid.cpp
+
+#include "SpatialHashGrid.h"
+
+namespace SpatialHashGridPrivate
+{
+    // 21 bits per axis, biased: ±10 km at 1 cm cells
+    constexpr int32 AxisBias = 1 << 20;
+    constexpr uint64 AxisMask = (uint64(1) << 21) - 1;
+
+    struct FCandidate
+    {
+        float DistSq;
+        int32 Id;
+    };
+
+    /** Insert into a list sorted by distance, keeping at most K entries. */
+    void InsertCandidate(TArray<FCandidate, TInlineAllocator<16>>& Best, int32 K, float DistSq, int32 Id)
+    {
+        if (Best.Num() == K && DistSq >= Best.Last().DistSq)
+        {
+            return;
+        }
+        int32 At = Best.Num();
+        while (At > 0 && Best[At - 1].DistSq > DistSq)
+        {
+            --At;
+        }
+        Best.Insert(FCandidate{ DistSq, Id }, At);
+        if (Best.Num() > K)
+        {
+            Best.Pop(false);
+        }
+    }
+}
+
+FSpatialHashGrid::FSpatialHashGrid(float InCellSize)
+{
+    CellSize = FMath::Max(InCellSize, 1.0f);
+    InvCellSize = 1.0f / CellSize;
+}
+
+void FSpatialHashGrid::SetCellSize(float InCellSize)
+{
+    InCellSize = FMath::Max(InCellSize, 1.0f);
+    if (InCellSize == CellSize)
+    {
+        return;
+    }
+    CellSize = InCellSize;
+    InvCellSize = 1.0f / CellSize;
+
+    Cells.Reset();
+    for (int32 Id = 0; Id < Positions.Num(); ++Id)
+    {
+        if (ItemCell[Id] != InvalidCell)
+        {
+            Insert(Id, PackCell(CellCoord(Positions[Id])));
+        }
+    }
+}
+
+void FSpatialHashGrid::Reset()
+{
+    Positions.Reset();
+    ItemCell.Reset();
+    SlotInCell.Reset();
+    FreeIds.Reset();
+    Cells.Reset();
+}
+
+void FSpatialHashGrid::Rebuild(TConstArrayView<FVector> InPositions)
+{
+    Cells.Reset();
+    FreeIds.Reset();
+    Positions = InPositions;
+    ItemCell.SetNumUninitialized(Positions.Num());
+    SlotInCell.SetNumUninitialized(Positions.Num());
+    for (int32 Id = 0; Id < Positions.Num(); ++Id)
+    {
+        Insert(Id, PackCell(CellCoord(Positions[Id])));
+    }
+}
+
+int32 FSpatialHashGrid::Add(const FVector& Position)
+{
+    int32 Id;
+    if (FreeIds.Num() > 0)
+    {
+        Id = FreeIds.Pop(false);
+        Positions[Id] = Position;
+    }
+    else
+    {
+        Id = Positions.Add(Position);
+        ItemCell.Add(InvalidCell);
+        SlotInCell.Add(INDEX_NONE);
+    }
+    Insert(Id, PackCell(CellCoord(Position)));
+    return Id;
+}
+
+void FSpatialHashGrid::Move(int32 Id, const FVector& Position)
+{
+    if (!IsValidId(Id))
+    {
+        return;
+    }
+    Positions[Id] = Position;
+    const uint64 Cell = PackCell(CellCoord(Position));
+    if (Cell != ItemCell[Id])
+    {
+        Unlink(Id);
+        Insert(Id, Cell);
+    }
+}
+
+void FSpatialHashGrid::Remove(int32 Id)
+{
+    if (!IsValidId(Id))
+    {
+        return;
+    }
+    Unlink(Id);
+    ItemCell[Id] = InvalidCell;
+    SlotInCell[Id] = INDEX_NONE;
+    FreeIds.Add(Id);
+}
+
+FIntVector FSpatialHashGrid::CellCoord(const FVector& P) const
+{
+    return FIntVector(
+        FMath::FloorToInt(P.X * InvCellSize),
+        FMath::FloorToInt(P.Y * InvCellSize),
+        FMath::FloorToInt(P.Z * InvCellSize));
+}
+
+uint64 FSpatialHashGrid::PackCell(const FIntVector& C)
+{
+    using namespace SpatialHashGridPrivate;
+    return (uint64(C.X + AxisBias) & AxisMask)
+        | ((uint64(C.Y + AxisBias) & AxisMask) << 21)
+        | ((uint64(C.Z + AxisBias) & AxisMask) << 42);
+}
+
+void FSpatialHashGrid::Insert(int32 Id, uint64 Cell)
+{
+    TArray<int32>& Items = Cells.FindOrAdd(Cell);
+    ItemCell[Id] = Cell;
+    SlotInCell[Id] = Items.Add(Id);
+}
+
+void FSpatialHashGrid::Unlink(int32 Id)
+{
+    TArray<int32>* Items = Cells.Find(ItemCell[Id]);
+    if (!Items)
+    {
+        return;
+    }
+    const int32 Slot = SlotInCell[Id];
+    Items->RemoveAtSwap(Slot, 1, false);
+    if (Items->Num() == 0)
+    {
+        // Empty cells would slow down the fallback scans
+        Cells.Remove(ItemCell[Id]);
+    }
+    else if (Items->IsValidIndex(Slot))
+    {
+        SlotInCell[(*Items)[Slot]] = Slot;
+    }
+}
+
+template <typename FunctorType>
+void FSpatialHashGrid::ForEachInRing(const FIntVector& Origin, int32 Ring, FunctorType&& Visit) const
+{
+    auto VisitCell = [this, &Visit](const FIntVector& C)
+    {
+        if (const TArray<int32>* Items = Cells.Find(PackCell(C)))
+        {
+            for (const int32 Id : *Items)
+            {
+                Visit(Id);
+            }
+        }
+    };
+
+    if (Ring == 0)
+    {
+        VisitCell(Origin);
+        return;
+    }
+    for (int32 Z = -Ring; Z <= Ring; ++Z)
+    {
+        for (int32 Y = -Ring; Y <= Ring; ++Y)
+        {
+            if (FMath::Abs(Z) == Ring || FMath::Abs(Y) == Ring)
+            {
+                // Face of the ring: full row
+                for (int32 X = -Ring; X <= Ring; ++X)
+                {
+                    VisitCell(Origin + FIntVector(X, Y, Z));
+                }
+            }
+            else
+            {
+                // Interior row: only the two end cells are on the ring
+                VisitCell(Origin + FIntVector(-Ring, Y, Z));
+                VisitCell(Origin + FIntVector(Ring, Y, Z));
+            }
+        }
+    }
+}
+
+void FSpatialHashGrid::QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutIds) const
+{
+    OutIds.Reset();
+    if (Radius < 0.0f || Num() == 0)
+    {
+        return;
+    }
+    const float RadiusSq = Radius * Radius;
+    const FIntVector Min = CellCoord(Center - FVector(Radius));
+    const FIntVector Max = CellCoord(Center + FVector(Radius));
+
+    const int64 CellsInRange = int64(Max.X - Min.X + 1) * int64(Max.Y - Min.Y + 1) * int64(Max.Z - Min.Z + 1);
+    if (CellsInRange > Cells.Num())
+    {
+        // Radius much larger than the cells: walking the occupied cells is cheaper
+        for (const TPair<uint64, TArray<int32>>& Cell : Cells)
+        {
+            for (const int32 Id : Cell.Value)
+            {
+                if (FVector::DistSquared(Positions[Id], Center) <= RadiusSq)
+                {
+                    OutIds.Add(Id);
+                }
+            }
+        }
+        return;
+    }
+
+    for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+    {
+        for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+        {
+            for (int32 X = Min.X; X <= Max.X; ++X)
+            {
+                const TArray<int32>* Items = Cells.Find(PackCell(FIntVector(X, Y, Z)));
+                if (!Items)
+                {
+                    continue;
+                }
+                for (const int32 Id : *Items)
+                {
+                    if (FVector::DistSquared(Positions[Id], Center) <= RadiusSq)
+                    {
+                        OutIds.Add(Id);
+                    }
+                }
+            }
+        }
+    }
+}
+
+int32 FSpatialHashGrid::FindNearest(const FVector& Center, float MaxRadius) const
+{
+    TArray<int32> Result;
+    QueryKNearest(Center, 1, MaxRadius, Result);
+    return Result.Num() > 0 ? Result[0] : INDEX_NONE;
+}
+
+void FSpatialHashGrid::QueryKNearest(const FVector& Center, int32 K, float MaxRadius, TArray<int32>& OutIds) const
+{
+    using namespace SpatialHashGridPrivate;
+
+    OutIds.Reset();
+    const int32 Live = Num();
+    if (K <= 0 || MaxRadius < 0.0f || Live == 0)
+    {
+        return;
+    }
+    K = FMath::Min(K, Live);
+    const float MaxRadiusSq = MaxRadius * MaxRadius;
+    const FIntVector Origin = CellCoord(Center);
+
+    // Rings past MaxRadius cannot hold a hit
+    const int32 MaxRing = FMath::Min(FMath::CeilToInt(MaxRadius * InvCellSize) + 1, AxisBias);
+
+    TArray<FCandidate, TInlineAllocator<16>> Best;
+    int32 Visited = 0;
+    for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+    {
+        const int64 Side = 2 * int64(Ring) + 1;
+        const int64 CellsInRing = Ring == 0 ? 1 : Side * Side * Side - (Side - 2) * (Side - 2) * (Side - 2);
+        if (CellsInRing > Cells.Num())
+        {
+            // Sparse far-away items: the rings are now mostly empty, scan everything once
+            Best.Reset();
+            for (const TPair<uint64, TArray<int32>>& Cell : Cells)
+            {
+                for (const int32 Id : Cell.Value)
+                {
+                    const float DistSq = FVector::DistSquared(Positions[Id], Center);
+                    if (DistSq <= MaxRadiusSq)
+                    {
+                        InsertCandidate(Best, K, DistSq, Id);
+                    }
+                }
+            }
+            break;
+        }
+
+        ForEachInRing(Origin, Ring, [&](int32 Id)
+        {
+            ++Visited;
+            const float DistSq = FVector::DistSquared(Positions[Id], Center);
+            if (DistSq <= MaxRadiusSq)
+            {
+                InsertCandidate(Best, K, DistSq, Id);
+            }
+        });
+
+        // Anything in ring R+1 is at least R cells away from Center
+        const float NextRingDist = Ring * CellSize;
+        if ((Best.Num() == K && Best.Last().DistSq <= NextRingDist * NextRingDist) || Visited >= Live)
+        {
+            break;
+        }
+    }
+
+    OutIds.Reserve(Best.Num());
+    for (const FCandidate& Candidate : Best)
+    {
+        OutIds.Add(Candidate.Id);
+    }
+}
@@ -0,0 +1,33 @@
+// StreamingPcmSoundWave.cpp
+
+#include "StreamingPcmSoundWave.h"
+#include "PcmStreamSource.h"
+
+void UStreamingPcmSoundWave::SetSource(const TSharedPtr<FPcmStreamSource, ESPMode::ThreadSafe>& InSource)
+{
+    Source = InSource;
+    if (Source.IsValid())
+    {
+        SetSampleRate(uint32(Source->GetSampleRate()));
+        NumChannels = Source->GetNumChannels();
+    }
+    // End of song is detected by the owning component, not by the mixer.
+    Duration = INDEFINITELY_LOOPING_DURATION;
+    bLooping = false;
+}
+
+int32 UStreamingPcmSoundWave::OnGeneratePCMAudio(TArray<uint8>& OutAudio, int32 NumSamples)
+{
+    OutAudio.SetNumUninitialized(NumSamples * sizeof(float));
+    float* Out = reinterpret_cast<float*>(OutAudio.GetData());
+
+    if (Source.IsValid())
+    {
+        Source->ReadPlayback(Out, NumSamples);
+    }
+    else
+    {
+        FMemory::Memzero(Out, NumSamples * sizeof(float));
+    }
+    return NumSamples;
+}
@@ -0,0 +1,211 @@
+// StreamingSongComponent.cpp
+
+#include "StreamingSongComponent.h"
+#include "StreamingPcmSoundWave.h"
+#include "PcmStreamSource.h"
+#include "DecodedPcmCache.h"
+#include "SongLibrarySubsystem.h"
+#include "Components/AudioComponent.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Async/Async.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogStreamingSong, Log, All);
+
+UStreamingSongComponent::UStreamingSongComponent()
+{
+    // Only ticks while playing, to notice the end of the stream.
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+    PrimaryComponentTick.TickInterval = 0.1f;
+}
+
+void UStreamingSongComponent::OpenSong(const FString& FilePath)
+{
+    if (bOpening)
+    {
+        UE_LOG(LogStreamingSong, Warning, TEXT("OpenSong(%s) ignored, another song is still being prepared."), *FilePath);
+        return;
+    }
+
+    Stop();
+    CachePath.Empty();
+    ContentHash.Empty();
+
+    FString KnownHash;
+    UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+    if (USongLibrarySubsystem* Library = GameInstance ? GameInstance->GetSubsystem<USongLibrarySubsystem>() : nullptr)
+    {
+        FSongLibraryEntry Entry;
+        if (Library->FindSong(FilePath, Entry))
+        {
+            KnownHash = Entry.ContentHash;
+        }
+    }
+
+    bOpening = true;
+    TWeakObjectPtr<UStreamingSongComponent> WeakThis(this);
+    Async(EAsyncExecution::ThreadPool, [WeakThis, FilePath, KnownHash]()
+        {
+            const FString Hash = KnownHash.IsEmpty() ? USongLibrarySubsystem::HashFileContents(FilePath) : KnownHash;
+            bool bSuccess = !Hash.IsEmpty();
+            if (bSuccess && !FDecodedPcmCache::Exists(Hash))
+            {
+                UE_LOG(LogStreamingSong, Log, TEXT("No PCM cache for %s yet, decoding once."), *FilePath);
+                bSuccess = FDecodedPcmCache::DecodeFileToCache(FilePath, Hash, EDecodedPcmFormat::Int16);
+            }
+
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, Hash, bSuccess]()
+                {
+                    if (UStreamingSongComponent* Self = WeakThis.Get())
+                    {
+                        Self->FinishOpen(Hash, bSuccess);
+                    }
+                });
+        });
+}
+
+void UStreamingSongComponent::FinishOpen(const FString& InHash, bool bSuccess)
+{
+    bOpening = false;
+
+    if (bSuccess)
+    {
+        // Validate the header once; mapping is virtual only and released right away.
+        FMappedDecodedPcm Mapped;
+        bSuccess = Mapped.Open(FDecodedPcmCache::GetCachePath(InHash), InHash);
+        if (bSuccess)
+        {
+            CachePath = FDecodedPcmCache::GetCachePath(InHash);
+            ContentHash = InHash;
+            SampleRate = int32(Mapped.GetHeader().SampleRate);
+            NumChannels = int32(Mapped.GetHeader().NumChannels);
+        }
+    }
+
+    OnSongReady.Broadcast(bSuccess);
+}
+
+bool UStreamingSongComponent::Play()
+{
+    if (!IsSongReady())
+    {
+        UE_LOG(LogStreamingSong, Warning, TEXT("Play() without an opened song."));
+        return false;
+    }
+
+    Stop();
+
+    Source = MakeShared<FPcmStreamSource, ESPMode::ThreadSafe>(PlaybackRingSamples, ChunkFrames, AnalysisRingSamples);
+    if (!Source->Open(CachePath, ContentHash))
+    {
+        Source.Reset();
+        return false;
+    }
+
+    if (!AudioComponent)
+    {
+        AudioComponent = NewObject<UAudioComponent>(GetOwner());
+        AudioComponent->bAutoActivate = false;
+        AudioComponent->RegisterComponent();
+    }
+
+    SoundWave = NewObject<UStreamingPcmSoundWave>(this);
+    SoundWave->SetSource(Source);
+    AudioComponent->SetSound(SoundWave);
+    AudioComponent->Play();
+
+    AnalysisWindow.Reset();
+    AnalysisValid = 0;
+    SetComponentTickEnabled(true);
+
+    UE_LOG(LogStreamingSong, Log, TEXT("Streaming %s (%d Hz, %d ch, %.1f s), %llu KB resident."),
+        *CachePath, SampleRate, NumChannels, Source->GetDurationSeconds(), uint64(Source->GetAllocatedSize() / 1024));
+    return true;
+}
+
+void UStreamingSongComponent::Stop()
+{
+    SetComponentTickEnabled(false);
+
+    if (AudioComponent && SoundWave && AudioComponent->Sound == SoundWave)
+    {
+        AudioComponent->Stop();
+    }
+    if (Source.IsValid())
+    {
+        // The sound wave may still reference the source until the mixer releases it; it then just reads silence.
+        Source->Shutdown();
+        Source.Reset();
+    }
+    SoundWave = nullptr;
+}
+
+bool UStreamingSongComponent::IsPlaying() const
+{
+    return Source.IsValid() && !Source->IsFinished();
+}
+
+float UStreamingSongComponent::GetPlaybackTimeSeconds() const
+{
+    return Source.IsValid() ? float(Source->GetPlaybackSeconds()) : 0.f;
+}
+
+int32 UStreamingSongComponent::GetUnderrunCount() const
+{
+    return Source.IsValid() ? Source->GetUnderrunCount() : 0;
+}
+
+bool UStreamingSongComponent::GetLatestAnalysisFrames(int32 NumFrames, TArray<float>& OutFrames)
+{
+    if (!Source.IsValid() || NumFrames <= 0)
+    {
+        return false;
+    }
+
+    const int32 WindowSamples = NumFrames * NumChannels;
+    if (AnalysisWindow.Num() != WindowSamples)
+    {
+        AnalysisWindow.Init(0.f, WindowSamples);
+        AnalysisValid = 0;
+    }
+
+    constexpr int32 ScratchSamples = 4096;
+    AnalysisScratch.SetNumUninitialized(ScratchSamples);
+
+    int32 Got;
+    while ((Got = Source->ReadAnalysis(AnalysisScratch.GetData(), ScratchSamples)) > 0)
+    {
+        if (Got >= WindowSamples)
+        {
+            FMemory::Memcpy(AnalysisWindow.GetData(), AnalysisScratch.GetData() + (Got - WindowSamples), WindowSamples * sizeof(float));
+        }
+        else
+        {
+            FMemory::Memmove(AnalysisWindow.GetData(), AnalysisWindow.GetData() + Got, (WindowSamples - Got) * sizeof(float));
+            FMemory::Memcpy(AnalysisWindow.GetData() + (WindowSamples - Got), AnalysisScratch.GetData(), Got * sizeof(float));
+        }
+        AnalysisValid = FMath::Min(WindowSamples, AnalysisValid + Got);
+    }
+
+    OutFrames = AnalysisWindow;
+    return AnalysisValid == WindowSamples;
+}
+
+void UStreamingSongComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    if (Source.IsValid() && Source->IsFinished())
+    {
+        Stop();
+        OnSongFinished.Broadcast();
+    }
+}
+
+void UStreamingSongComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    Stop();
+    Super::EndPlay(EndPlayReason);
+}
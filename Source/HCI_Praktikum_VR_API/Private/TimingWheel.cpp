@@ -0,0 +1,154 @@
+// TimingWheel.cpp
+
+#include "TimingWheel.h"
+#include "Algo/Sort.h"
+
+void FTimingWheel::Init(double InTickSeconds, double InOrigin)
+{
+    TickSeconds = FMath::Max(InTickSeconds, 1e-5);
+    Origin = InOrigin;
+    CurrentTick = 0;
+    Count = 0;
+
+    Nodes.Reset();
+    FreeHead = INDEX_NONE;
+    Overflow.Reset();
+    for (int32 Level = 0; Level < NumLevels; ++Level)
+    {
+        for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+        {
+            Heads[Level][Slot] = INDEX_NONE;
+        }
+    }
+}
+
+void FTimingWheel::Schedule(double Time, int32 Payload)
+{
+    int32 NodeIndex = FreeHead;
+    if (NodeIndex != INDEX_NONE)
+    {
+        FreeHead = Nodes[NodeIndex].Next;
+    }
+    else
+    {
+        NodeIndex = Nodes.AddUninitialized();
+    }
+
+    Nodes[NodeIndex] = { Time, Payload, INDEX_NONE };
+    Insert(NodeIndex);
+    ++Count;
+}
+
+void FTimingWheel::Insert(int32 NodeIndex)
+{
+    const int64 Tick = FMath::Max(TickOf(Nodes[NodeIndex].Time), CurrentTick);
+    const int64 Delta = Tick - CurrentTick;
+
+    // The slot of level L is re-filed exactly when the current tick enters the
+    // block of 2^(Bits*L) ticks that contains Tick.
+    for (int32 Level = 0; Level < NumLevels; ++Level)
+    {
+        if (Delta < (int64(1) << (Bits * (Level + 1))))
+        {
+            int32& Head = Heads[Level][(Tick >> (Bits * Level)) & Mask];
+            Nodes[NodeIndex].Next = Head;
+            Head = NodeIndex;
+            return;
+        }
+    }
+    Overflow.Add(NodeIndex);
+}
+
+void FTimingWheel::Cascade(int32 Level)
+{
+    const int32 Index = int32(CurrentTick >> (Bits * Level)) & Mask;
+
+    // Refill this level from the one above first when it wraps as well.
+    if (Index == 0)
+    {
+        if (Level + 1 < NumLevels)
+        {
+            Cascade(Level + 1);
+        }
+        else
+        {
+            const TArray<int32> Pending = MoveTemp(Overflow);
+            for (const int32 NodeIndex : Pending)
+            {
+                Insert(NodeIndex);
+            }
+        }
+    }
+
+    int32 NodeIndex = Heads[Level][Index];
+    Heads[Level][Index] = INDEX_NONE;
+    while (NodeIndex != INDEX_NONE)
+    {
+        const int32 Next = Nodes[NodeIndex].Next;
+        Insert(NodeIndex);
+        NodeIndex = Next;
+    }
+}
+
+void FTimingWheel::Release(int32 NodeIndex)
+{
+    Nodes[NodeIndex].Next = FreeHead;
+    FreeHead = NodeIndex;
+    --Count;
+}
+
+void FTimingWheel::Advance(double UpTo, TArray<FEntry>& OutDue)
+{
+    const int32 FirstOut = OutDue.Num();
+    const int64 Target = TickOf(UpTo);
+
+    if (Count == 0)
+    {
+        // Nothing filed anywhere, so jumping keeps every slot consistent.
+        CurrentTick = FMath::Max(CurrentTick, Target);
+        return;
+    }
+
+    // Whole ticks that have elapsed: everything in their slot is due.
+    while (CurrentTick < Target)
+    {
+        int32& Head = Heads[0][CurrentTick & Mask];
+        int32 NodeIndex = Head;
+        Head = INDEX_NONE;
+        while (NodeIndex != INDEX_NONE)
+        {
+            const int32 Next = Nodes[NodeIndex].Next;
+            OutDue.Add({ Nodes[NodeIndex].Time, Nodes[NodeIndex].Payload });
+            Release(NodeIndex);
+            NodeIndex = Next;
+        }
+
+        ++CurrentTick;
+        if ((CurrentTick & Mask) == 0)
+        {
+            Cascade(1);
+        }
+    }
+
+    // The current tick is only partly over.
+    int32* Link = &Heads[0][CurrentTick & Mask];
+    while (*Link != INDEX_NONE)
+    {
+        const int32 NodeIndex = *Link;
+        if (Nodes[NodeIndex].Time < UpTo)
+        {
+            *Link = Nodes[NodeIndex].Next;
+            OutDue.Add({ Nodes[NodeIndex].Time, Nodes[NodeIndex].Payload });
+            Release(NodeIndex);
+        }
+        else
+        {
+            Link = &Nodes[NodeIndex].Next;
+        }
+    }
+
+    if (OutDue.Num() - FirstOut > 1)
+    {
+        Algo::SortBy(MakeArrayView(OutDue.GetData() + FirstOut, OutDue.Num() - FirstOut), &FEntry::Time);
+    }
+}
@@ -0,0 +1,138 @@
+// AnalysisQualityControllerComponent.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "AnalysisQualityControllerComponent.generated.h"
+
+class UMelOverbandAnalyzerComponent;
+class UHarmonicPercussiveComponent;
+
+/** One analysis quality level. Tiers are ordered from highest (index 0) to cheapest. */
+USTRUCT(BlueprintType)
+struct FAnalysisQualityTier
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Quality")
+    FName Name = TEXT("Medium");
+
+    /** FFT frame size; AATools has to be re-initialized with it in OnQualityTierChanged. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Quality", meta = (ClampMin = "128"))
+    int32 FFTSize = 1024;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Quality", meta = (ClampMin = "1"))
+    int32 OverBandCount = 16;
+
+    /** Analyze every Nth frame only (1 = every frame). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Quality", meta = (ClampMin = "1"))
+    int32 HopDivisor = 1;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Quality")
+    bool bHarmonicPercussive = true;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnQualityTierChanged, int32, TierIndex, const FAnalysisQualityTier&, Tier);
+
+/**
+ * Keeps the audio analysis inside a CPU budget. The analyzer and separator time
+ * their own Process calls; this component averages that cost and steps one tier
+ * down when it stays above the budget, or one tier up when it stays well below,
+ * each only after a hold time so tiers do not flap. Envelope state survives tier
+ * changes (see UMelOverbandAnalyzerComponent::Reconfigure), and every change is
+ * appended to Saved/StudyResults/AnalysisQuality/ so results can be matched to
+ * the quality they were produced with.
+ */
+UCLASS(ClassGroup = Audio, meta = (BlueprintSpawnableComponent))
+class HCI_PRAKTIKUM_VR_API_API UAnalysisQualityControllerComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UAnalysisQualityControllerComponent();
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Quality")
+    TArray<FAnalysisQualityTier> Tiers;
+
+    /** Analysis CPU budget per analyzed frame in ms. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Quality", meta = (ClampMin = "0.01"))
+    float BudgetMs = 1.f;
+
+    /** Step up only while the cost is below this fraction of the budget. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Quality", meta = (ClampMin = "0", ClampMax = "1"))
+    float StepUpFraction = 0.5f;
+
+    /** Seconds the cost must stay over budget before stepping down. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Quality", meta = (ClampMin = "0"))
+    float StepDownHoldSeconds = 1.f;
+
+    /** Seconds the cost must stay under StepUpFraction before stepping up. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Quality", meta = (ClampMin = "0"))
+    float StepUpHoldSeconds = 10.f;
+
+    /** Smoothing of the measured cost (0 = none, close to 1 = slow). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Quality", meta = (ClampMin = "0", ClampMax = "0.999"))
+    float CostSmoothing = 0.9f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Quality")
+    bool bLogTierChanges = true;
+
+    /** Fired after a tier was applied; re-initialize AATools with Tier.FFTSize here. */
+    UPROPERTY(BlueprintAssignable, Category = "Audio|Quality")
+    FOnQualityTierChanged OnQualityTierChanged;
+
+    /** Components to measure and reconfigure. Separator may be null. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Quality")
+    void SetTargets(UMelOverbandAnalyzerComponent* InAnalyzer, UHarmonicPercussiveComponent* InSeparator, int32 InitialTier = 0);
+
+    /** Optionally wrap the AATools ProcessAudioFrames call, so the plugin FFT is part of the cost. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Quality")
+    void BeginExternalMeasure();
+
+    UFUNCTION(BlueprintCallable, Category = "Audio|Quality")
+    void EndExternalMeasure();
+
+    /** False on frames skipped by the current tier's HopDivisor. */
+    UFUNCTION(BlueprintPure, Category = "Audio|Quality")
+    bool ShouldAnalyzeThisFrame() const { return bAnalyzeThisFrame; }
+
+    UFUNCTION(BlueprintCallable, Category = "Audio|Quality")
+    void SetTier(int32 TierIndex, const FString& Reason = TEXT("Manual"));
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Quality")
+    int32 GetCurrentTier() const { return CurrentTier; }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Quality")
+    float GetSmoothedCostMs() const { return SmoothedCostMs; }
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+    virtual void BeginPlay() override;
+
+private:
+    void ApplyTier(int32 TierIndex);
+    void ApplyPendingAnalyzerTier();
+    void AppendTierLog(int32 FromTier, int32 ToTier, const FString& Reason);
+
+    UPROPERTY()
+    TObjectPtr<UMelOverbandAnalyzerComponent> Analyzer;
+
+    UPROPERTY()
+    TObjectPtr<UHarmonicPercussiveComponent> Separator;
+
+    int32 CurrentTier = INDEX_NONE;
+    /** CurrentTier's FFT size/band count still has to reach the analyzer (set before SetAnalyzer). */
+    bool bAnalyzerTierPending = false;
+    int32 FrameCounter = 0;
+    bool bAnalyzeThisFrame = true;
+
+    uint64 ExternalStartCycles = 0;
+    float ExternalMs = 0.f;
+    float SmoothedCostMs = 0.f;
+    float OverBudgetSeconds = 0.f;
+    float UnderBudgetSeconds = 0.f;
+
+    FString TierLogPath;
+};
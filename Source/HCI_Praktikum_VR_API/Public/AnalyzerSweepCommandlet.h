@@ -0,0 +1,32 @@
+// AnalyzerSweepCommandlet.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AnalyzerSweepCommandlet.generated.h"
+
+/**
+ * Offline grid search over the over-band analyzer parameters.
+ *
+ *   UnrealEditor-Cmd HCI_Praktikum_VR_API.uproject -run=AnalyzerSweep
+ *       [-Songs="a.mp3;b.mp3"] [-Folder=Content/Musik] [-Bands=16] [-FFT=1024] [-FPS=72]
+ *       [-DecayEnv=0.8:0.95:0.05] [-DecayPeak=0.9,0.95,0.99] [-LogScaleG=...] [-ThreshAlpha=...]
+ *       [-AttackCoef=...] [-VisSmoothAlpha=...] [-Normalization=Quantile [-QuantileDecay=0.999]]
+ *       [-Out=Saved/AnalyzerSweep/sweep.csv]
+ *
+ * Grids are either "Min:Max:Step" or a comma list; omitted parameters keep the
+ * analyzer default. Spectra are computed once per song and cached; all
+ * configurations then run in parallel on the cached band averages. One CSV row
+ * per configuration with dynamic range, jitter energy and onset response.
+ */
+UCLASS()
+class HCI_PRAKTIKUM_VR_API_API UAnalyzerSweepCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UAnalyzerSweepCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
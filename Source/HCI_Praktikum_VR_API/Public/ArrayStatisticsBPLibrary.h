@@ -0,0 +1,90 @@
+// ArrayStatisticsBPLibrary.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "ArrayStatisticsBPLibrary.generated.h"
+
+/** Summary of a float array. Variance is the population variance (divide by N). */
+USTRUCT(BlueprintType)
+struct FArrayStatistics
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+    int32 Num = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+    float Mean = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+    float Variance = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+    float StdDev = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+    float Min = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+    float Max = 0.f;
+
+    /** INDEX_NONE for empty arrays; first occurrence on ties. */
+    UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+    int32 MinIndex = INDEX_NONE;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+    int32 MaxIndex = INDEX_NONE;
+};
+
+UENUM(BlueprintType)
+enum class EArrayNormalization : uint8
+{
+    /** (x – mean) / stddev */
+    ZScore  UMETA(DisplayName = "Z-Score"),
+    /** (x – min) / (max – min) */
+    MinMax  UMETA(DisplayName = "Min-Max"),
+    /** x / max */
+    Max     UMETA(DisplayName = "Divide by Max")
+};
+
+/**
+ * Native replacements for the generic array nodes in the feature graphs
+ * (Simple Mean, Find Max, Standatize, ...). Reductions run four lanes per SIMD
+ * register in a single pass; transforms write in place or into a caller-owned
+ * array, so no temporary copies are made.
+ */
+UCLASS()
+class HCI_PRAKTIKUM_VR_API_API UArrayStatisticsBPLibrary : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+
+public:
+    /** Mean and variance in one pass (Welford per lane, lanes merged with Chan's formula). */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Statistics")
+    static void ArrayMeanVariance(const TArray<float>& Values, float& OutMean, float& OutVariance, float& OutStdDev);
+
+    UFUNCTION(BlueprintCallable, Category = "Audio|Statistics")
+    static void ArrayMinMax(const TArray<float>& Values, float& OutMin, int32& OutMinIndex, float& OutMax, int32& OutMaxIndex);
+
+    /** Everything above in a single pass. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Statistics")
+    static FArrayStatistics ArrayStatistics(const TArray<float>& Values);
+
+    /** (x – mean) / stddev in place. A constant array becomes all zeros. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Statistics")
+    static void ZScoreInPlace(UPARAM(ref) TArray<float>& Values, float& OutMean, float& OutStdDev);
+
+    /** (x – min) / (max – min) in place. A constant array becomes all zeros. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Statistics")
+    static void NormalizeMinMaxInPlace(UPARAM(ref) TArray<float>& Values, float& OutMin, float& OutMax);
+
+    /** Fused statistics + normalization; OutValues may be the input array. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Statistics")
+    static void StatisticsAndNormalize(const TArray<float>& Values, EArrayNormalization Mode, TArray<float>& OutValues, FArrayStatistics& OutStatistics);
+
+    /** Native entry points for raw buffers. */
+    static void ComputeStatistics(const float* Values, int32 Num, FArrayStatistics& OutStatistics);
+    static void Normalize(const float* Values, int32 Num, const FArrayStatistics& Statistics, EArrayNormalization Mode, float* OutValues);
+};
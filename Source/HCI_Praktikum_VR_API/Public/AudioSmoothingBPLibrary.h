@@ -12,7 +12,10 @@ class HCI_PRAKTIKUM_VR_API_API UAudioSmoothingBPLibrary : public UBlueprintFunct
     GENERATED_BODY()
 
 public:
-    /** Simple Moving Average over a sliding window. */
+    /**
+     * Simple Moving Average over a sliding window.
+     * Copies and re-sums the buffer every call; prefer UMovingAverageSmoother for per-frame use.
+     */
     UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
     static void SMA_Smooth(
         const TArray<float>& InBuffer,
@@ -29,7 +32,10 @@ public:
         float& InOutPrevSmoothed,
         float& OutSmoothed);
 
-    /** 3‑point median filter: median of [ prev[-1], prev[0], NewSample ] */
+    /**
+     * 3‑point median filter: median of [ prev[-1], prev[0], NewSample ]
+     * For longer windows or many bands use USlidingMedianSmoother.
+     */
     UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
     static void Median3_Smooth(
         const TArray<float>& InBuffer,
@@ -58,4 +64,30 @@ public:
         float Gamma,
         float& InOutPrevBaseline,
         float& OutEnhanced);
+
+    /**
+     * EMA_Smooth for a whole feature array in one call (e.g. all bands), vectorized.
+     * InOutPrevSmoothed holds one state per element and is grown with zeros if needed.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    static void EMA_SmoothArray(
+        const TArray<float>& NewSamples,
+        float Alpha,
+        UPARAM(ref) TArray<float>& InOutPrevSmoothed,
+        TArray<float>& OutSmoothed);
+
+    /**
+     * PulseEnhance_Smooth for a whole feature array in one call, vectorized.
+     * The gamma warp uses a fast pow approximation (relative error < 5e-4).
+     * InOutPrevBaseline holds one state per element and is grown with zeros if needed.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    static void PulseEnhance_SmoothArray(
+        const TArray<float>& NewSamples,
+        float BaselineAlpha,
+        float MinRatio,
+        float MaxRatio,
+        float Gamma,
+        UPARAM(ref) TArray<float>& InOutPrevBaseline,
+        TArray<float>& OutEnhanced);
 };
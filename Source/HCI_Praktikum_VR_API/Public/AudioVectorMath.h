@@ -0,0 +1,64 @@
+// AudioVectorMath.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+
+/**
+ * Fast approximations for per-band feature math. FastLog2/FastExp2 work on the
+ * float bit pattern plus a rational correction term (relative error of
+ * FastPow below 5e-4), which is plenty for visual mappings and several times
+ * cheaper than FMath::Pow. Inputs to FastPow must be >= 0; 0 maps to ~1e-38.
+ */
+namespace AudioVectorMath
+{
+    FORCEINLINE float FastLog2(float X)
+    {
+        const uint32 Bits = FPlatformMath::AsUInt(X);
+        const float Mantissa = FPlatformMath::AsFloat((Bits & 0x007FFFFFu) | 0x3F000000u);
+        return float(Bits) * 1.1920928955078125e-7f - 124.22551499f
+            - 1.498030302f * Mantissa - 1.72587999f / (0.3520887068f + Mantissa);
+    }
+
+    FORCEINLINE float FastExp2(float P)
+    {
+        const float Clipped = FMath::Max(P, -126.f);
+        const float Z = Clipped - FMath::FloorToFloat(Clipped);
+        const float Scaled = float(1 << 23) * (Clipped + 121.2740575f + 27.7280233f / (4.84252568f - Z) - 1.49012907f * Z);
+        return FPlatformMath::AsFloat(uint32(Scaled));
+    }
+
+    FORCEINLINE float FastPow(float Base, float Exponent)
+    {
+        return FastExp2(Exponent * FastLog2(Base));
+    }
+
+    FORCEINLINE VectorRegister4Float VectorFastLog2(const VectorRegister4Float& X)
+    {
+        const VectorRegister4Int Bits = VectorCastFloatToInt(X);
+        const VectorRegister4Float Mantissa = VectorCastIntToFloat(
+            VectorIntOr(VectorIntAnd(Bits, VectorIntSet1(0x007FFFFF)), VectorIntSet1(0x3F000000)));
+        // Bits of a non-negative float are a non-negative int32, so the signed conversion is exact enough.
+        const VectorRegister4Float Y = VectorMultiply(VectorIntToFloat(Bits), VectorSetFloat1(1.1920928955078125e-7f));
+        return VectorSubtract(
+            VectorNegateMultiplyAdd(VectorSetFloat1(1.498030302f), Mantissa, VectorSubtract(Y, VectorSetFloat1(124.22551499f))),
+            VectorDivide(VectorSetFloat1(1.72587999f), VectorAdd(VectorSetFloat1(0.3520887068f), Mantissa)));
+    }
+
+    FORCEINLINE VectorRegister4Float VectorFastExp2(const VectorRegister4Float& P)
+    {
+        const VectorRegister4Float Clipped = VectorMax(P, VectorSetFloat1(-126.f));
+        const VectorRegister4Float Z = VectorSubtract(Clipped, VectorFloor(Clipped));
+        const VectorRegister4Float Sum = VectorSubtract(
+            VectorAdd(VectorAdd(Clipped, VectorSetFloat1(121.2740575f)),
+                VectorDivide(VectorSetFloat1(27.7280233f), VectorSubtract(VectorSetFloat1(4.84252568f), Z))),
+            VectorMultiply(VectorSetFloat1(1.49012907f), Z));
+        return VectorCastIntToFloat(VectorFloatToInt(VectorMultiply(VectorSetFloat1(float(1 << 23)), Sum)));
+    }
+
+    FORCEINLINE VectorRegister4Float VectorFastPow(const VectorRegister4Float& Base, const VectorRegister4Float& Exponent)
+    {
+        return VectorFastExp2(VectorMultiply(Exponent, VectorFastLog2(Base)));
+    }
+}
@@ -0,0 +1,71 @@
+// BandQuantileTracker.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Streaming low/high quantiles for many bands at once.
+ *
+ * Each band keeps an exponentially decaying histogram over log2(value) with a
+ * fixed number of bins, so memory is constant and old material fades out with
+ * the given per-frame decay. Decay is applied lazily: instead of scaling every
+ * bin each frame, new values are added with a weight that grows by 1/Decay per
+ * frame, and everything is renormalized when that weight gets large. Each band
+ * remembers its low/high quantile bin and the weight below it; an update adds
+ * to one bin and moves those positions by the few bins the distribution shifted,
+ * so the per-frame cost does not depend on the bin count.
+ *
+ * Unlike the peak tracker this stays scalar: every band reads and writes a
+ * data-dependent bin and walks its cursors a data-dependent distance, which
+ * needs gather/scatter rather than lane-wise math. Expect roughly 10x the peak
+ * tracker's per-band cost (about 20 ns per band on desktop x86).
+ */
+class HCI_PRAKTIKUM_VR_API_API FBandQuantileTracker
+{
+public:
+    static constexpr int32 NumBins = 128;
+    static constexpr float MinLog2 = -24.f;     // ~6e-8
+    static constexpr float BinsPerOctave = 4.f; // 1.5 dB resolution, 32 octaves
+
+    void Init(int32 InNumBands, float InLowQuantile, float InHighQuantile, float InDecay);
+    void Reset();
+
+    /** Change the band count; each new band inherits the histogram of the nearest old band. */
+    void ResizeBands(int32 InNumBands);
+
+    void SetQuantiles(float InLowQuantile, float InHighQuantile);
+    void SetDecay(float InDecay) { Decay = FMath::Clamp(InDecay, 0.f, 0.99999f); }
+
+    /** Add one value per band and refresh the quantile estimates. */
+    void Update(const float* Values);
+
+    float GetLow(int32 Band) const { return Low[Band]; }
+    float GetHigh(int32 Band) const { return High[Band]; }
+
+private:
+    /** A quantile position: the bin holding the target and the weight of all bins below it. */
+    struct FCursor
+    {
+        int32 Bin = 0;
+        float Below = 0.f;
+    };
+
+    /** Move a cursor until Below < Target <= Below + Histogram[Bin]. */
+    static void Seek(const float* Bins, FCursor& Cursor, float Target);
+
+    /** Divide out the accumulated weight scale and recompute the cursors exactly. */
+    void Renormalize();
+
+    int32 NumBands = 0;
+    float LowQuantile = 0.05f;
+    float HighQuantile = 0.95f;
+    float Decay = 0.999f;
+    float InsertWeight = 1.f;   // weight of a value added this frame, in histogram units
+    float TotalWeight = 0.f;    // identical for every band, same units
+    int32 FramesSinceRenormalize = 0;
+
+    TArray<float> Histogram;    // [Band * NumBins + Bin]
+    TArray<FCursor> LowCursor, HighCursor;
+    TArray<float> Low, High;    // quantile values per band
+};
@@ -0,0 +1,45 @@
+// BandpassFilterBank.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+
+/**
+ * Time-domain band energies without an FFT: one biquad bandpass per band plus a
+ * per-sample power follower, four bands per SIMD register. Levels can be read
+ * after any number of samples, so the latency is the filters' group delay and
+ * the follower time constant instead of a whole FFT frame.
+ */
+class HCI_PRAKTIKUM_VR_API_API FBandpassFilterBank
+{
+public:
+    /**
+     * One band per pair of neighbouring edges (Hz), e.g. the analyzer's Mel edges.
+     * SmoothingMs is the time constant of the power follower.
+     */
+    void Init(float InSampleRate, const TArray<float>& BandEdgesHz, float SmoothingMs = 10.f);
+    void Reset();
+
+    /** Feed mono samples. */
+    void Process(const float* Samples, int32 NumSamples);
+
+    /** RMS level per band (NumBands values), comparable to a mean band magnitude. */
+    void GetLevels(float* OutLevels) const;
+
+    int32 GetNumBands() const { return NumBands; }
+    float GetSampleRate() const { return SampleRate; }
+
+private:
+    struct FGroup
+    {
+        VectorRegister4Float B0, B2, A1, A2;  // bandpass: B1 = 0
+        VectorRegister4Float Z1, Z2;
+        VectorRegister4Float Power;
+    };
+
+    float SampleRate = 0.f;
+    int32 NumBands = 0;
+    VectorRegister4Float SmoothCoef;
+    TArray<FGroup> Groups;
+};
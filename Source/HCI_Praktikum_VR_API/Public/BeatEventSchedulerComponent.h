@@ -0,0 +1,163 @@
+// BeatEventSchedulerComponent.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "TimingWheel.h"
+#include "BeatEventSchedulerComponent.generated.h"
+
+class UNiagaraComponent;
+class UStreamingSongComponent;
+
+/** A visual event at a point on the song's audio clock. */
+USTRUCT(BlueprintType)
+struct FBeatVisualEvent
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Beats")
+    FName EventName;
+
+    /** Seconds on the audio clock. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Beats")
+    float AudioTime = 0.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Beats")
+    float Value = 1.f;
+
+    /** Set on dispatch: seconds from the start of the frame to the event (negative if late). */
+    UPROPERTY(BlueprintReadOnly, Category = "Audio|Beats")
+    float FrameOffset = 0.f;
+};
+
+/** Writes due events of one name into a Niagara component's user parameters. */
+USTRUCT(BlueprintType)
+struct FBeatNiagaraBinding
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Beats")
+    TObjectPtr<UNiagaraComponent> Component;
+
+    /** Event name to forward; None forwards all events. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Beats")
+    FName EventName;
+
+    /** Float: sub-frame offset of the first event this frame, e.g. to delay a spawn burst. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Beats")
+    FName OffsetParameter = TEXT("User.BeatOffset");
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Beats")
+    FName ValueParameter = TEXT("User.BeatValue");
+
+    /** Int: incremented once per event, so the system can detect new beats. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Beats")
+    FName CounterParameter = TEXT("User.BeatCounter");
+
+    int32 Counter = 0;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBeatEvents, const TArray<FBeatVisualEvent>&, Events);
+
+/**
+ * Fires visual events on beats without per-actor polling.
+ *
+ * Events are queued against the audio clock of a UStreamingSongComponent in a
+ * timing wheel. At the start of every frame, all events that fall into the
+ * coming frame are dispatched in one batch: to Niagara bindings as user
+ * parameters and to OnBeatEvents. Each event carries its offset inside the
+ * frame, so effects can be placed more precisely than the frame rate.
+ *
+ * The audio clock advances in audio buffer steps; it is extrapolated with the
+ * frame time and pulled towards the reported position, and resynced (with the
+ * wheel rebuilt from the pending events) after seeks or hitches. Dispatched and
+ * skipped events free their slot, so a backward seek does not replay them.
+ */
+UCLASS(ClassGroup = Audio, meta = (BlueprintSpawnableComponent))
+class HCI_PRAKTIKUM_VR_API_API UBeatEventSchedulerComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UBeatEventSchedulerComponent();
+
+    /** Clock source. Without one, the world time is used. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Beats")
+    TObjectPtr<UStreamingSongComponent> StreamingSong;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Beats")
+    TArray<FBeatNiagaraBinding> NiagaraBindings;
+
+    /** Fraction of the clock error corrected per frame. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Beats", meta = (ClampMin = "0", ClampMax = "1"))
+    float ClockCorrection = 0.1f;
+
+    /** Clock errors above this (seconds) are treated as a seek. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Beats", meta = (ClampMin = "0.01"))
+    float ResyncThresholdSeconds = 0.25f;
+
+    UPROPERTY(BlueprintAssignable, Category = "Audio|Beats")
+    FOnBeatEvents OnBeatEvents;
+
+    UFUNCTION(BlueprintCallable, Category = "Audio|Beats")
+    void ScheduleEvent(FName EventName, float AudioTime, float Value = 1.f);
+
+    UFUNCTION(BlueprintCallable, Category = "Audio|Beats")
+    void ScheduleBeats(FName EventName, const TArray<float>& AudioTimes, float Value = 1.f);
+
+    /**
+     * Detect onsets of the current song from its cached offline spectrogram on a
+     * worker thread and schedule them as EventName.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Beats")
+    void ScheduleCachedOnsets(FName EventName, int32 FrameSize = 1024, int32 HopSize = 512);
+
+    /** Drop pending events of one name; their slots are reused once the wheel lets go of them. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Beats")
+    void CancelEvents(FName EventName);
+
+    /** Drop all events, e.g. when a new song is opened. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Beats")
+    void ClearEvents();
+
+    UFUNCTION(BlueprintCallable, Category = "Audio|Beats")
+    void AddNiagaraBinding(UNiagaraComponent* Component, FName EventName);
+
+    /** Smoothed audio clock at the start of this frame. */
+    UFUNCTION(BlueprintPure, Category = "Audio|Beats")
+    float GetAudioClockSeconds() const { return float(Clock); }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Beats")
+    int32 GetNumPendingEvents() const { return Wheel.Num(); }
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+    virtual void BeginPlay() override;
+
+private:
+    double ReadAudioClock() const;
+    void Resync(double Now);
+    void Dispatch(double FrameStart);
+    void FreeEvent(int32 Index);
+
+    enum class EEventSlot : uint8
+    {
+        Free,
+        Pending,
+        /** Still filed in the wheel; freed when it comes due. */
+        Cancelled
+    };
+
+    static constexpr double WheelTickSeconds = 0.002;
+
+    TArray<FBeatVisualEvent> Events;
+    TArray<EEventSlot> EventSlots;
+    TArray<int32> FreeEvents;
+    FTimingWheel Wheel;
+    double Clock = 0.0;
+
+    TArray<FTimingWheel::FEntry> DueScratch;
+    TArray<FBeatVisualEvent> Batch;
+};
@@ -0,0 +1,56 @@
+// CachedAudioImporter.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "CachedAudioImporter.generated.h"
+
+class URuntimeAudioImporterLibrary;
+class UImportedSoundWave;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnCachedAudioImported, UImportedSoundWave*, SoundWave, bool, bFromCache, float, ImportSeconds);
+
+/**
+ * Drop-in for RuntimeAudioImporter's ImportAudioFromFile that keeps the decoded
+ * samples in Saved/SongLibrary/Cache/<hash>/decoded.pcm. The first import decodes
+ * and writes the cache; later imports memory-map it and skip decoding entirely.
+ * Keep a reference to the returned object until OnImported fired.
+ */
+UCLASS(BlueprintType)
+class HCI_PRAKTIKUM_VR_API_API UCachedAudioImporter : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /** Sample format used when a new cache file is written. Int16 halves disk size and read bandwidth. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Import")
+    bool bStoreAsInt16 = true;
+
+    /** Fired on the game thread. SoundWave is null if the import failed. */
+    UPROPERTY(BlueprintAssignable, Category = "Audio|Import")
+    FOnCachedAudioImported OnImported;
+
+    UFUNCTION(BlueprintCallable, Category = "Audio|Import")
+    static UCachedAudioImporter* CreateCachedAudioImporter();
+
+    /** Import an audio file, from the PCM cache when possible. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Import")
+    void ImportAudioFromFile(const FString& FilePath);
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Import")
+    bool IsImporting() const { return bIsImporting; }
+
+private:
+    UPROPERTY()
+    TObjectPtr<URuntimeAudioImporterLibrary> Importer;
+
+    FString CurrentFile;
+    double ImportStartTime = 0.0;
+    bool bFromCache = false;
+    bool bIsImporting = false;
+
+    void OnImporterResult(URuntimeAudioImporterLibrary* InImporter, UImportedSoundWave* SoundWave, ERuntimeImportStatus Status);
+    void Fail(const FString& Reason);
+};
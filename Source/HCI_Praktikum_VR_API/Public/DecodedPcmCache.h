@@ -0,0 +1,94 @@
+// DecodedPcmCache.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/** Sample format of a decoded.pcm cache file. */
+enum class EDecodedPcmFormat : uint8
+{
+    Float32 = 0,
+    Int16 = 1,
+};
+
+/** Fixed 64-byte header in front of the interleaved samples, so sample data is aligned for direct use. */
+struct HCI_PRAKTIKUM_VR_API_API FDecodedPcmHeader
+{
+    static constexpr uint32 ExpectedMagic = 0x4D435048; // "HPCM"
+    static constexpr uint32 CurrentVersion = 1;
+
+    uint32 Magic = ExpectedMagic;
+    uint32 Version = CurrentVersion;
+    uint32 SampleRate = 0;
+    uint32 NumChannels = 0;
+    uint64 NumFrames = 0;
+    uint8 Format = uint8(EDecodedPcmFormat::Float32);
+    uint8 Reserved[7] = {};
+    /** Content hash of the source file (hex, not null-terminated). */
+    ANSICHAR ContentHash[16] = {};
+    uint8 Padding[16] = {};
+
+    int32 GetBytesPerSample() const { return Format == uint8(EDecodedPcmFormat::Int16) ? 2 : 4; }
+    uint64 GetDataSize() const { return NumFrames * NumChannels * GetBytesPerSample(); }
+
+    /** Magic, version, format, hash and payload size check against the file it was read from. */
+    bool IsValidFor(const FString& ExpectedHash, uint64 FileSize) const;
+};
+static_assert(sizeof(FDecodedPcmHeader) == 64, "Decoded PCM header layout changed");
+
+/**
+ * Read-only memory mapping of a decoded.pcm file. The sample views point straight
+ * into the mapping and stay valid as long as this object lives.
+ */
+class HCI_PRAKTIKUM_VR_API_API FMappedDecodedPcm
+{
+public:
+    FMappedDecodedPcm();
+    ~FMappedDecodedPcm();
+
+    FMappedDecodedPcm(const FMappedDecodedPcm&) = delete;
+    FMappedDecodedPcm& operator=(const FMappedDecodedPcm&) = delete;
+
+    /** Map the file and validate it against ExpectedHash. Returns false (and stays closed) on any mismatch. */
+    bool Open(const FString& Path, const FString& ExpectedHash);
+    void Close();
+
+    bool IsOpen() const { return Data != nullptr; }
+    const FDecodedPcmHeader& GetHeader() const { return Header; }
+    EDecodedPcmFormat GetFormat() const { return EDecodedPcmFormat(Header.Format); }
+
+    /** Raw sample bytes, header excluded. */
+    TArrayView64<const uint8> GetBytes() const;
+
+    /** Empty if the file is not in that format. */
+    TArrayView64<const float> GetFloatSamples() const;
+    TArrayView64<const int16> GetInt16Samples() const;
+
+    /** Copy interleaved samples [StartSample, StartSample + Num) as float, converting if needed. Returns samples copied. */
+    int64 ReadFloat(int64 StartSample, float* Out, int64 Num) const;
+
+private:
+    TUniquePtr<IMappedFileHandle> Handle;
+    TUniquePtr<IMappedFileRegion> Region;
+    FDecodedPcmHeader Header;
+    const uint8* Data = nullptr;
+};
+
+/** Location and (de)serialization of the per-song decoded PCM cache. */
+struct HCI_PRAKTIKUM_VR_API_API FDecodedPcmCache
+{
+    /** <Saved>/SongLibrary/Cache/<hash>/decoded.pcm */
+    static FString GetCachePath(const FString& ContentHash);
+
+    static bool Exists(const FString& ContentHash);
+
+    /** Write interleaved float samples. Goes through a temp file, so readers never see a partial cache. */
+    static bool Write(const FString& ContentHash, TArrayView64<const float> Samples, int32 SampleRate, int32 NumChannels, EDecodedPcmFormat Format);
+
+    /** Decode an audio file with RuntimeAudioImporter and write its cache. Blocking; needs the whole song in memory once. */
+    static bool DecodeFileToCache(const FString& FilePath, const FString& ContentHash, EDecodedPcmFormat Format);
+};
@@ -0,0 +1,63 @@
+// FeatureSmoothingComponent.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "FeatureSmoothingPipelineAsset.h"
+#include "FeatureSmoothingComponent.generated.h"
+
+/**
+ * Runs a UFeatureSmoothingPipelineAsset for one visualization. Set the raw
+ * features each frame, call Process once, then read the smoothed values.
+ * The asset is compiled when play begins or when a new one is assigned.
+ */
+UCLASS(ClassGroup = Audio, meta = (BlueprintSpawnableComponent))
+class HCI_PRAKTIKUM_VR_API_API UFeatureSmoothingComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UFeatureSmoothingComponent();
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Audio|Smoothing")
+    TObjectPtr<UFeatureSmoothingPipelineAsset> Pipeline;
+
+    /** Assign and compile a pipeline; all smoothing state starts fresh. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    void SetPipeline(UFeatureSmoothingPipelineAsset* InPipeline);
+
+    /** Scalar input (band 0). */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    void SetFeatureValue(FName FeatureName, float Value);
+
+    /** Per-band input; extra values are ignored, missing ones keep their last input. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    void SetFeatureArray(FName FeatureName, const TArray<float>& Values);
+
+    /** Run all stages of all features. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    void Process();
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Smoothing")
+    float GetFeatureValue(FName FeatureName, int32 Band = 0) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    void GetFeatureArray(FName FeatureName, TArray<float>& OutValues) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    void ResetState() { Program.Reset(); }
+
+    FFeatureSmoothingProgram& GetProgram() { return Program; }
+
+protected:
+    virtual void BeginPlay() override;
+
+private:
+    int32 FindFeatureChecked(FName FeatureName) const;
+
+    FFeatureSmoothingProgram Program;
+
+    /** Missing features already reported; getters run every frame, so each is logged once per pipeline. */
+    mutable TSet<FName> WarnedMissingFeatures;
+};
@@ -0,0 +1,158 @@
+// FeatureSmoothingPipelineAsset.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "SlidingMedian.h"
+#include "FeatureSmoothingPipelineAsset.generated.h"
+
+/** One smoothing/normalization step, applied to every band of a feature. */
+UENUM(BlueprintType)
+enum class EFeatureSmoothingOp : uint8
+{
+    /** y = a·x + (1–a)·y₋₁ (EMA_Smooth). */
+    EMA             UMETA(DisplayName = "EMA"),
+    /** Mean of the last Window values (SMA_Smooth). */
+    MovingAverage   UMETA(DisplayName = "Moving Average"),
+    /** Running median of the last Window values. */
+    Median          UMETA(DisplayName = "Median"),
+    /** Divide by a slowly decaying running maximum (Find Max + divide). */
+    MaxNormalize    UMETA(DisplayName = "Max Normalize"),
+    /** (x – mean) / stddev with exponentially weighted statistics. */
+    Standardize     UMETA(DisplayName = "Standardize"),
+    /** Baseline ratio, threshold and gamma warp (PulseEnhance_Smooth). */
+    PulseEnhance    UMETA(DisplayName = "Pulse Enhance"),
+    /** x·Gain + Offset. */
+    Scale           UMETA(DisplayName = "Scale"),
+    Clamp           UMETA(DisplayName = "Clamp")
+};
+
+USTRUCT(BlueprintType)
+struct FFeatureSmoothingStage
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing")
+    EFeatureSmoothingOp Op = EFeatureSmoothingOp::EMA;
+
+    /** EMA / Standardize / PulseEnhance baseline coefficient. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing", meta = (ClampMin = "0", ClampMax = "1",
+        EditCondition = "Op == EFeatureSmoothingOp::EMA || Op == EFeatureSmoothingOp::Standardize || Op == EFeatureSmoothingOp::PulseEnhance", EditConditionHides))
+    float Alpha = 0.2f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing", meta = (ClampMin = "1",
+        EditCondition = "Op == EFeatureSmoothingOp::MovingAverage || Op == EFeatureSmoothingOp::Median", EditConditionHides))
+    int32 Window = 5;
+
+    /** Per-frame decay of the running maximum. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing", meta = (ClampMin = "0", ClampMax = "1",
+        EditCondition = "Op == EFeatureSmoothingOp::MaxNormalize", EditConditionHides))
+    float Decay = 0.995f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing", meta = (EditCondition = "Op == EFeatureSmoothingOp::PulseEnhance", EditConditionHides))
+    float MinRatio = 1.2f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing", meta = (EditCondition = "Op == EFeatureSmoothingOp::PulseEnhance", EditConditionHides))
+    float MaxRatio = 3.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing", meta = (EditCondition = "Op == EFeatureSmoothingOp::PulseEnhance", EditConditionHides))
+    float Gamma = 2.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing", meta = (EditCondition = "Op == EFeatureSmoothingOp::Scale", EditConditionHides))
+    float Gain = 1.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing", meta = (EditCondition = "Op == EFeatureSmoothingOp::Scale", EditConditionHides))
+    float Offset = 0.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing", meta = (EditCondition = "Op == EFeatureSmoothingOp::Clamp", EditConditionHides))
+    float ClampMin = 0.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing", meta = (EditCondition = "Op == EFeatureSmoothingOp::Clamp", EditConditionHides))
+    float ClampMax = 1.f;
+};
+
+/** A named feature (scalar or per-band) and the stages it runs through, in order. */
+USTRUCT(BlueprintType)
+struct FFeatureSmoothingPipeline
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing")
+    FName FeatureName;
+
+    /** 1 for scalar features, e.g. the over-band count for band arrays. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing", meta = (ClampMin = "1"))
+    int32 NumBands = 1;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smoothing")
+    TArray<FFeatureSmoothingStage> Stages;
+};
+
+/**
+ * Flat native form of a pipeline asset. All feature inputs live in one lane
+ * buffer, which is copied into the output lanes at the start of a frame, and
+ * all stage state in one float buffer; each instruction runs one stage over the
+ * contiguous output lanes of one feature, so a frame is a single pass over a
+ * short instruction list with no VM or per-band calls.
+ */
+class HCI_PRAKTIKUM_VR_API_API FFeatureSmoothingProgram
+{
+public:
+    void Compile(const TArray<FFeatureSmoothingPipeline>& Pipelines);
+    void Reset();
+
+    /** Copy the input lanes to the output lanes and run every instruction over them in place. */
+    void Execute();
+
+    int32 FindFeature(FName FeatureName) const;
+    int32 GetNumFeatures() const { return Features.Num(); }
+    int32 GetNumBands(int32 Feature) const { return Features[Feature].NumLanes; }
+
+    /** Input lanes of a feature; they keep their value until set again. */
+    TArrayView<float> GetInputLanes(int32 Feature) { return TArrayView<float>(Inputs.GetData() + Features[Feature].FirstLane, Features[Feature].NumLanes); }
+
+    /** Output lanes of a feature after the last Execute. */
+    TConstArrayView<float> GetLanes(int32 Feature) const { return TConstArrayView<float>(Lanes.GetData() + Features[Feature].FirstLane, Features[Feature].NumLanes); }
+
+private:
+    struct FFeatureLayout
+    {
+        FName Name;
+        int32 FirstLane = 0;
+        int32 NumLanes = 0;
+    };
+
+    struct FInstruction
+    {
+        EFeatureSmoothingOp Op;
+        int32 FirstLane;
+        int32 NumLanes;
+        int32 StateOffset;    // into State
+        int32 CounterOffset;  // into Counters (moving average head/count)
+        int32 Window;
+        int32 MedianIndex;    // into Medians
+        float P0, P1, P2, P3;
+    };
+
+    TArray<FFeatureLayout> Features;
+    TArray<FInstruction> Instructions;
+    TArray<float> Inputs;
+    TArray<float> Lanes;
+    TArray<float> State;
+    TArray<int32> Counters;
+    TArray<FSlidingMedianBank> Medians;
+};
+
+/** Designer-facing description of how each feature is smoothed and normalized. */
+UCLASS(BlueprintType)
+class HCI_PRAKTIKUM_VR_API_API UFeatureSmoothingPipelineAsset : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Smoothing")
+    TArray<FFeatureSmoothingPipeline> Features;
+
+    void Compile(FFeatureSmoothingProgram& OutProgram) const { OutProgram.Compile(Features); }
+};
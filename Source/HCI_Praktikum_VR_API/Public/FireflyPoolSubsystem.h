@@ -0,0 +1,108 @@
+// FireflyPoolSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "FireflyPoolSubsystem.generated.h"
+
+USTRUCT(BlueprintType)
+struct FActorPoolStats
+{
+    GENERATED_BODY()
+
+    /** Acquires served from parked instances. */
+    UPROPERTY(BlueprintReadOnly, Category = "Pooling")
+    int32 Hits = 0;
+
+    /** Acquires that had to spawn. */
+    UPROPERTY(BlueprintReadOnly, Category = "Pooling")
+    int32 Misses = 0;
+
+    /** Acquires that took the oldest active instance because the cap was reached. */
+    UPROPERTY(BlueprintReadOnly, Category = "Pooling")
+    int32 Recycled = 0;
+
+    /** Most instances active at the same time. */
+    UPROPERTY(BlueprintReadOnly, Category = "Pooling")
+    int32 HighWaterMark = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Pooling")
+    int32 Active = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Pooling")
+    int32 Free = 0;
+};
+
+/**
+ * Per-class actor pools for fireflies (Firefly, Firefly_Left, Firefly_Right,
+ * Firefly_Floor, Firefly_Light, ...), so grab-spawn interactions reuse parked
+ * instances instead of constructing, registering and later garbage collecting
+ * actors.
+ *
+ * Released actors are hidden, lose collision and tick, and their Niagara
+ * components are deactivated. On acquire they are moved into place, their
+ * default_… statistics are restored from the class defaults and their Niagara
+ * components are reset, then IPoolableActor::OnAcquiredFromPool runs. Prewarm
+ * at level start to keep spawning out of the interaction itself.
+ *
+ * Active instances are registered in the "Fireflies" layer of the proximity
+ * grid, so hand interactions can query them instead of using overlaps.
+ */
+UCLASS()
+class HCI_PRAKTIKUM_VR_API_API UFireflyPoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UFireflyPoolSubsystem* Get(const UObject* WorldContextObject);
+
+    /** UProximityGridSubsystem layer that holds the root components of active instances. */
+    static const FName ProximityLayer;
+
+    virtual void Deinitialize() override;
+
+    /** Spawn parked instances until Count are available (active + free). */
+    UFUNCTION(BlueprintCallable, Category = "Pooling")
+    void Prewarm(TSubclassOf<AActor> ActorClass, int32 Count);
+
+    /** Max instances of a class (0 = unbounded). At the cap, Acquire recycles the oldest active one. */
+    UFUNCTION(BlueprintCallable, Category = "Pooling")
+    void SetPoolCap(TSubclassOf<AActor> ActorClass, int32 MaxInstances);
+
+    UFUNCTION(BlueprintCallable, Category = "Pooling", meta = (DeterminesOutputType = "ActorClass"))
+    AActor* AcquireActor(TSubclassOf<AActor> ActorClass, const FTransform& Transform);
+
+    /** Park an actor acquired from this pool; other actors are destroyed. */
+    UFUNCTION(BlueprintCallable, Category = "Pooling")
+    void ReleaseActor(AActor* Actor);
+
+    UFUNCTION(BlueprintPure, Category = "Pooling")
+    FActorPoolStats GetPoolStats(TSubclassOf<AActor> ActorClass) const;
+
+    /** Destroy all parked instances of a class (active ones are left alone). */
+    UFUNCTION(BlueprintCallable, Category = "Pooling")
+    void TrimPool(TSubclassOf<AActor> ActorClass);
+
+private:
+    struct FPool
+    {
+        TArray<TWeakObjectPtr<AActor>> Free;
+        /** Oldest acquire first. */
+        TArray<TWeakObjectPtr<AActor>> Active;
+        /** default_… properties restored from the CDO on acquire. */
+        TArray<FProperty*> StatisticProperties;
+        int32 Cap = 0;
+        bool bPropertiesResolved = false;
+        FActorPoolStats Stats;
+    };
+
+    FPool& GetPool(UClass* ActorClass);
+    AActor* SpawnParked(UClass* ActorClass, FPool& Pool);
+    void Park(AActor* Actor) const;
+    void Activate(AActor* Actor, FPool& Pool, const FTransform& Transform) const;
+
+    TMap<TObjectKey<UClass>, FPool> Pools;
+    TMap<TObjectKey<AActor>, TObjectKey<UClass>> Owned;
+};
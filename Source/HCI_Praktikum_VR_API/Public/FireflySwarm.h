@@ -0,0 +1,187 @@
+// FireflySwarm.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "FireflySwarm.generated.h"
+
+class UNiagaraComponent;
+class UInstancedStaticMeshComponent;
+class UMelOverbandAnalyzerComponent;
+class UForceFieldSetComponent;
+
+UENUM(BlueprintType)
+enum class EFireflySwarmRenderMode : uint8
+{
+    /** Array DIs on one Niagara system; one particle per firefly, indexed by ExecIndex. */
+    Niagara         UMETA(DisplayName = "Niagara Arrays"),
+    /** One instance per firefly; brightness in custom data float 0. */
+    InstancedMesh   UMETA(DisplayName = "Instanced Static Mesh")
+};
+
+/**
+ * Thousands of fireflies as plain arrays instead of actors.
+ *
+ * State is kept as structure-of-arrays (position, velocity, band, brightness,
+ * phase). Each tick the fireflies are binned into a spatial hash, then updated
+ * in chunks with ParallelFor: boids flocking over hash neighbours, pull/push
+ * from the force-field set, a soft bound around the actor, and an audio
+ * response where each firefly's brightness and speed follow its assigned
+ * over-band. Reads come from the previous state and writes go to a second
+ * buffer, so chunks never share written data.
+ *
+ * Rendering is one Niagara system fed through array data interfaces
+ * (User.FireflyPositions as Array Vector, User.FireflyBrightness as Array Float,
+ * User.FireflyCount as int) or one instanced static mesh.
+ */
+UCLASS()
+class HCI_PRAKTIKUM_VR_API_API AFireflySwarm : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AFireflySwarm();
+
+    virtual void Tick(float DeltaTime) override;
+
+    /** Re-seed all fireflies (deterministic for a given Seed). */
+    UFUNCTION(BlueprintCallable, Category = "Firefly Swarm")
+    void ResetSwarm();
+
+    UFUNCTION(BlueprintCallable, Category = "Firefly Swarm")
+    void SetAudioSource(UMelOverbandAnalyzerComponent* InAnalyzer) { Analyzer = InAnalyzer; }
+
+    UFUNCTION(BlueprintCallable, Category = "Firefly Swarm")
+    void SetForceFields(UForceFieldSetComponent* InForceFields) { ForceFields = InForceFields; }
+
+    UFUNCTION(BlueprintPure, Category = "Firefly Swarm")
+    int32 GetNumFireflies() const { return Position.Num(); }
+
+    /** Simulation time of the last tick in ms (binning + update + upload). */
+    UFUNCTION(BlueprintPure, Category = "Firefly Swarm")
+    float GetLastUpdateMs() const { return LastUpdateMs; }
+
+    // --- Population ---
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Firefly Swarm", meta = (ClampMin = "1", ClampMax = "65536"))
+    int32 NumFireflies = 2000;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Firefly Swarm")
+    int32 Seed = 1337;
+
+    /** Half size of the box (actor space) the swarm is kept in. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm")
+    FVector SwarmExtent = FVector(500.0, 500.0, 200.0);
+
+    /** Fireflies per ParallelFor task. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm", meta = (ClampMin = "16"))
+    int32 ChunkSize = 256;
+
+    // --- Motion ---
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Motion", meta = (ClampMin = "1"))
+    float NeighborRadius = 60.0f;
+
+    /** Neighbours considered per firefly; bounds the cost in dense clumps. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Motion", meta = (ClampMin = "1"))
+    int32 MaxNeighbors = 12;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Motion")
+    float SeparationWeight = 1.5f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Motion")
+    float AlignmentWeight = 0.5f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Motion")
+    float CohesionWeight = 0.3f;
+
+    /** Scales the force-field strengths (cm/s² per unit strength). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Motion")
+    float ForceFieldWeight = 400.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Motion")
+    float BoundsWeight = 2.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Motion")
+    float WanderStrength = 30.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Motion", meta = (ClampMin = "1"))
+    float MaxSpeed = 80.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Motion", meta = (ClampMin = "0"))
+    float Drag = 0.5f;
+
+    // --- Audio ---
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Audio")
+    float BaseBrightness = 0.2f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Audio")
+    float AudioBrightnessGain = 1.0f;
+
+    /** Extra max speed at band value 1, as a fraction of MaxSpeed. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Audio")
+    float AudioSpeedGain = 0.5f;
+
+    /** Brightness follow rate in 1/s. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Audio", meta = (ClampMin = "0"))
+    float BrightnessResponse = 10.0f;
+
+    // --- Rendering ---
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Firefly Swarm|Rendering")
+    EFireflySwarmRenderMode RenderMode = EFireflySwarmRenderMode::Niagara;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Firefly Swarm|Rendering")
+    TObjectPtr<UNiagaraComponent> SwarmSystem;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Firefly Swarm|Rendering")
+    TObjectPtr<UInstancedStaticMeshComponent> SwarmMesh;
+
+    /** Uniform instance scale in InstancedMesh mode. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firefly Swarm|Rendering")
+    float InstanceScale = 0.05f;
+
+protected:
+    virtual void BeginPlay() override;
+
+private:
+    void BuildGrid();
+    void SimulateRange(int32 Begin, int32 End, float DeltaTime, const FVector3f& Center, const TArray<float>& Bands, const TArray<FVector4>& Fields);
+    void Upload();
+
+    FORCEINLINE FIntVector CellOf(const FVector3f& P) const
+    {
+        return FIntVector(FMath::FloorToInt(P.X * InvCellSize), FMath::FloorToInt(P.Y * InvCellSize), FMath::FloorToInt(P.Z * InvCellSize));
+    }
+    FORCEINLINE uint32 HashCell(const FIntVector& C) const
+    {
+        return ((uint32(C.X) * 73856093u) ^ (uint32(C.Y) * 19349663u) ^ (uint32(C.Z) * 83492791u)) & HashMask;
+    }
+
+    UPROPERTY()
+    TObjectPtr<UMelOverbandAnalyzerComponent> Analyzer;
+
+    UPROPERTY()
+    TObjectPtr<UForceFieldSetComponent> ForceFields;
+
+    // Structure-of-arrays state (world space), double-buffered for the parallel update
+    TArray<FVector3f> Position;
+    TArray<FVector3f> Velocity;
+    TArray<FVector3f> NextPosition;
+    TArray<FVector3f> NextVelocity;
+    TArray<float> Brightness;
+    TArray<float> Phase;
+    TArray<uint16> Band;
+
+    // Spatial hash: fireflies sorted by cell hash, CellStart[h]..CellStart[h+1]
+    TArray<int32> CellStart;
+    TArray<int32> SortedIndex;
+    TArray<uint32> CellHash;
+    uint32 HashMask = 0;
+    float InvCellSize = 1.0f;
+
+    // Upload scratch, reused every frame
+    TArray<FVector> UploadPositions;
+    TArray<FTransform> UploadTransforms;
+
+    float Time = 0.0f;
+    float LastUpdateMs = 0.0f;
+};
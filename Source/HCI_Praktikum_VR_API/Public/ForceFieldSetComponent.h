@@ -0,0 +1,152 @@
+// ForceFieldSetComponent.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "ForceFieldSetComponent.generated.h"
+
+class UNiagaraComponent;
+class USceneComponent;
+
+UENUM(BlueprintType)
+enum class EForceFieldType : uint8
+{
+    Attractor   UMETA(DisplayName = "Attractor"),
+    Repulsor    UMETA(DisplayName = "Repulsor"),
+    Vortex      UMETA(DisplayName = "Vortex"),
+    Drag        UMETA(DisplayName = "Drag")
+};
+
+/** One force emitter; follows a scene component (hand, pawn, ...) or sits at a fixed location. */
+USTRUCT(BlueprintType)
+struct FForceFieldSource
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Field")
+    FName Name;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Field")
+    bool bEnabled = true;
+
+    /** Actor to follow; empty = this component's owner. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Field")
+    TObjectPtr<AActor> SourceActor;
+
+    /** Scene component tag on SourceActor, e.g. "LeftHand"; None = its root. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Field")
+    FName ComponentTag;
+
+    /** Do not follow anything; Offset is a world location. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Field")
+    bool bFixedLocation = false;
+
+    /** Offset in the followed component's space (or world location when fixed). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Field")
+    FVector Offset = FVector::ZeroVector;
+
+    /** Falloff distance in cm. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Field", meta = (ClampMin = "0.0"))
+    float Radius = 100.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Field")
+    float Strength = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Field")
+    EForceFieldType Type = EForceFieldType::Attractor;
+
+    /** Resolved at BeginPlay / AddForceField. */
+    TWeakObjectPtr<USceneComponent> Followed;
+};
+
+/**
+ * A variable number of force fields sent to Niagara as one packed array.
+ *
+ * Every tick the fields are moved to their followed components, culled
+ * against the bounds of the target systems, capped to MaxForceFields (nearest
+ * first) and written to an Array Vector4 user parameter with two entries per
+ * field, in world space:
+ *
+ *   [2i]     = (Position.X, Position.Y, Position.Z, Radius)
+ *   [2i + 1] = (Strength, Type, 0, 0)
+ *
+ * plus the live count in an int parameter. Another attractor is just another
+ * array element; the Niagara module loops over the count.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class HCI_PRAKTIKUM_VR_API_API UForceFieldSetComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UForceFieldSetComponent();
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Force Fields")
+    TArray<FForceFieldSource> ForceFields;
+
+    /** Upper bound of fields sent per frame (the Niagara loop bound). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Fields", meta = (ClampMin = "1", ClampMax = "256"))
+    int32 MaxForceFields = 16;
+
+    /** Extra distance beyond a field's radius before it is culled; < 0 disables culling. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Fields")
+    float CullMargin = 50.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Fields|Niagara")
+    FName ArrayParameter = TEXT("User.ForceFields");
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Fields|Niagara")
+    FName CountParameter = TEXT("User.ForceFieldCount");
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Fields|Niagara")
+    TArray<TObjectPtr<UNiagaraComponent>> TargetComponents;
+
+    /** Actors whose Niagara components also receive the fields (via the target registry). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Force Fields|Niagara")
+    TArray<FString> TargetActorNameSubstrings;
+
+    /** Add or replace (by Name) a field at runtime. */
+    UFUNCTION(BlueprintCallable, Category = "Force Fields")
+    void AddForceField(const FForceFieldSource& Field);
+
+    UFUNCTION(BlueprintCallable, Category = "Force Fields")
+    bool RemoveForceField(FName Name);
+
+    UFUNCTION(BlueprintCallable, Category = "Force Fields")
+    bool SetForceFieldEnabled(FName Name, bool bEnabled);
+
+    UFUNCTION(BlueprintCallable, Category = "Force Fields")
+    bool SetForceFieldStrength(FName Name, float Strength, float Radius = -1.0f);
+
+    /** Re-collect target systems, e.g. after editing TargetComponents at runtime. */
+    UFUNCTION(BlueprintCallable, Category = "Force Fields|Niagara")
+    void RefreshTargets() { bTargetsDirty = true; }
+
+    /** Fields sent in the last upload. */
+    UFUNCTION(BlueprintPure, Category = "Force Fields")
+    int32 GetActiveCount() const { return ActiveCount; }
+
+    /** The packed array of the last tick (layout above), for native consumers. */
+    const TArray<FVector4>& GetPackedFields() const { return Packed; }
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+    void ResolveFollowed(FForceFieldSource& Field) const;
+    FForceFieldSource* FindField(FName Name);
+    void GatherTargets();
+
+    TArray<TWeakObjectPtr<UNiagaraComponent>> Targets;
+    uint32 TargetRevision = MAX_uint32;
+    bool bTargetsDirty = true;
+
+    /** (DistanceSquared to the bounds, field index) for the cap. */
+    TArray<TPair<float, int32>> Candidates;
+    TArray<FVector> Positions;
+    TArray<FVector4> Packed;
+    TArray<FVector4> UploadedPacked;
+    int32 ActiveCount = 0;
+};
@@ -0,0 +1,157 @@
+// FrameBudgetGovernorComponent.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "FrameBudgetGovernorComponent.generated.h"
+
+class UNiagaraComponent;
+
+/** A Niagara system whose load follows the governor's factor. */
+USTRUCT(BlueprintType)
+struct FGovernedNiagaraSystem
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability")
+    TObjectPtr<UNiagaraComponent> Component;
+
+    /** Float user parameter = BaseSpawnRate * factor; None = skip. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability")
+    FName SpawnRateParameter = TEXT("User.SpawnRate");
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability")
+    float BaseSpawnRate = 100.f;
+
+    /** Int user parameter = BaseMaxParticles * factor; None = skip. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability")
+    FName MaxParticlesParameter = TEXT("User.MaxParticles");
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability")
+    int32 BaseMaxParticles = 10000;
+
+    /** Float user parameter = factor itself (e.g. to scale update work in the system); None = skip. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability")
+    FName FactorParameter = TEXT("User.ScalabilityFactor");
+};
+
+/** A firefly (or any) actor whose tick rate follows the governor's factor. */
+USTRUCT(BlueprintType)
+struct FGovernedActor
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability")
+    TObjectPtr<AActor> Actor;
+
+    /** Tick interval at factor 1 (0 = every frame). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability", meta = (ClampMin = "0"))
+    float BaseTickInterval = 0.f;
+
+    /** Tick interval at MinFactor; linear in between. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability", meta = (ClampMin = "0"))
+    float MaxTickInterval = 0.1f;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnScalabilityFactorChanged, float, Factor, const FString&, Reason);
+
+/**
+ * Keeps frame time inside a budget by scaling visual load. Game, render and GPU
+ * frame times are read from the engine's frame stats (GGameThreadTime,
+ * GRenderThreadTime, RHIGetGPUFrameCycles) and smoothed; the slowest of them
+ * is compared to the budget. The factor steps down by StepSize when it stays
+ * over budget and back up when it stays well under, each after a hold time, so
+ * it only takes a few discrete values during a session.
+ *
+ * A new factor is applied to the registered Niagara systems (spawn rate, max
+ * particles) and actors (tick interval), broadcast, and appended with a
+ * timestamp to Saved/StudyResults/FrameBudget/ so stimulus changes can be
+ * matched to trials.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class HCI_PRAKTIKUM_VR_API_API UFrameBudgetGovernorComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UFrameBudgetGovernorComponent();
+
+    /** Frame budget in ms (13.9 = 72 Hz, 11.1 = 90 Hz). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability", meta = (ClampMin = "1"))
+    float BudgetMs = 13.9f;
+
+    /** Step up only while the slowest thread is below this fraction of the budget. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability", meta = (ClampMin = "0", ClampMax = "1"))
+    float StepUpFraction = 0.8f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability", meta = (ClampMin = "0"))
+    float StepDownHoldSeconds = 0.5f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability", meta = (ClampMin = "0"))
+    float StepUpHoldSeconds = 5.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability", meta = (ClampMin = "0.01", ClampMax = "1"))
+    float StepSize = 0.125f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability", meta = (ClampMin = "0.01", ClampMax = "1"))
+    float MinFactor = 0.25f;
+
+    /** Smoothing of the measured frame times (0 = none, close to 1 = slow). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability", meta = (ClampMin = "0", ClampMax = "0.999"))
+    float TimeSmoothing = 0.9f;
+
+    /** Freeze the factor, e.g. during a trial that must not change stimulus. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability")
+    bool bFrozen = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability")
+    bool bLogChanges = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability")
+    TArray<FGovernedNiagaraSystem> NiagaraSystems;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scalability")
+    TArray<FGovernedActor> Actors;
+
+    UPROPERTY(BlueprintAssignable, Category = "Scalability")
+    FOnScalabilityFactorChanged OnScalabilityFactorChanged;
+
+    UFUNCTION(BlueprintCallable, Category = "Scalability")
+    void RegisterNiagaraSystem(const FGovernedNiagaraSystem& System);
+
+    UFUNCTION(BlueprintCallable, Category = "Scalability")
+    void RegisterActor(AActor* Actor, float BaseTickInterval = 0.f, float MaxTickInterval = 0.1f);
+
+    UFUNCTION(BlueprintCallable, Category = "Scalability")
+    void UnregisterActor(AActor* Actor);
+
+    UFUNCTION(BlueprintCallable, Category = "Scalability")
+    void SetFactor(float InFactor, const FString& Reason = TEXT("Manual"));
+
+    UFUNCTION(BlueprintPure, Category = "Scalability")
+    float GetFactor() const { return Factor; }
+
+    /** Smoothed frame times in ms; GPU is 0 when the RHI does not report it. */
+    UFUNCTION(BlueprintPure, Category = "Scalability")
+    void GetFrameTimes(float& OutGameMs, float& OutRenderMs, float& OutGpuMs) const;
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+    virtual void BeginPlay() override;
+
+private:
+    void ApplyToNiagara(const FGovernedNiagaraSystem& System) const;
+    void ApplyToActor(const FGovernedActor& Governed) const;
+    void AppendLog(float FromFactor, const FString& Reason);
+
+    float Factor = 1.f;
+    float GameMs = 0.f;
+    float RenderMs = 0.f;
+    float GpuMs = 0.f;
+    float OverBudgetSeconds = 0.f;
+    float UnderBudgetSeconds = 0.f;
+
+    FString LogPath;
+};
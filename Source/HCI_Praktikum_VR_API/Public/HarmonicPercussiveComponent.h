@@ -0,0 +1,120 @@
+// HarmonicPercussiveComponent.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "AudioAnalysisToolsLibrary.h"
+#include "HarmonicPercussiveSeparator.h"
+#include "MelOverbandAnalyzerComponent.h"
+#include "HarmonicPercussiveComponent.generated.h"
+
+/** Spectral shape features of one spectrum, defined like the AudioAnalysisTools feature nodes. */
+USTRUCT(BlueprintType)
+struct FSpectralShapeFeatures
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Audio|Separation")
+    float CentroidHz = 0.f;
+
+    /** Peak magnitude over mean magnitude. */
+    UPROPERTY(BlueprintReadOnly, Category = "Audio|Separation")
+    float Crest = 0.f;
+
+    /** Geometric over arithmetic mean magnitude: near 1 for noise, near 0 for tones. */
+    UPROPERTY(BlueprintReadOnly, Category = "Audio|Separation")
+    float Flatness = 0.f;
+};
+
+/**
+ * Splits the AudioAnalysisTools magnitude spectrum into harmonic and percussive
+ * parts every hop, so drums and tonal content can drive different visuals.
+ * The separated spectra can be routed into UMelOverbandAnalyzerComponent via
+ * SetSpectrumSource, and GetSpectralShape computes the feature extractor's
+ * spectral features on the mixed, harmonic or percussive spectrum.
+ */
+UCLASS(ClassGroup = Audio, meta = (BlueprintSpawnableComponent))
+class HCI_PRAKTIKUM_VR_API_API UHarmonicPercussiveComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UHarmonicPercussiveComponent();
+
+    /** Time median length in hops. Longer = cleaner harmonics, but more lag (half the window). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Separation", meta = (ClampMin = "3"))
+    int32 HarmonicWindowFrames = 17;
+
+    /** Frequency median length in bins. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Separation", meta = (ClampMin = "3"))
+    int32 PercussiveWindowBins = 17;
+
+    /** Wiener mask exponent; higher = harder separation. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Separation", meta = (ClampMin = "0.5"))
+    float MaskPower = 2.f;
+
+    /** When false, Process returns immediately and the last spectra stay valid (set by quality tiers). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Separation")
+    bool bProcessingEnabled = true;
+
+    /** Bind to the Blueprint's AudioAnalysisToolsLibrary instance. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Separation")
+    void SetAnalyzer(UAudioAnalysisToolsLibrary* InAnalyzer, int32 InFrameSize, float InSampleRate);
+
+    /** After AATools->ProcessAudioFrames(...), call once per hop (before the over-band analyzer). */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Separation")
+    void Process();
+
+    /** Clear the time history, e.g. at song start. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Separation")
+    void ResetSeparation();
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Separation")
+    const TArray<float>& GetHarmonicSpectrum() const { return Separator.GetHarmonicSpectrum(); }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Separation")
+    const TArray<float>& GetPercussiveSpectrum() const { return Separator.GetPercussiveSpectrum(); }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Separation")
+    const TArray<float>& GetHarmonicMask() const { return Separator.GetHarmonicMask(); }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Separation")
+    const TArray<float>& GetPercussiveMask() const { return Separator.GetPercussiveMask(); }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Separation")
+    float GetHarmonicEnergy() const { return Separator.GetHarmonicEnergy(); }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Separation")
+    float GetPercussiveEnergy() const { return Separator.GetPercussiveEnergy(); }
+
+    /** Onset strength of the percussive part; good for firefly pulses. */
+    UFUNCTION(BlueprintPure, Category = "Audio|Separation")
+    float GetPercussiveFlux() const { return Separator.GetPercussiveFlux(); }
+
+    /** Brightness of the tonal content; good for color. */
+    UFUNCTION(BlueprintPure, Category = "Audio|Separation")
+    float GetHarmonicCentroidHz() const { return Separator.GetHarmonicCentroidHz(); }
+
+    /**
+     * Centroid, crest and flatness of the chosen spectrum after the last Process,
+     * in place of the AudioAnalysisTools nodes, which only see the mixed signal.
+     */
+    UFUNCTION(BlueprintPure, Category = "Audio|Separation")
+    FSpectralShapeFeatures GetSpectralShape(EOverbandSpectrumSource Source) const;
+
+    /** CPU time of the last Process call in ms. */
+    UFUNCTION(BlueprintPure, Category = "Audio|Separation")
+    float GetLastProcessMs() const { return LastProcessMs; }
+
+    const FHarmonicPercussiveSeparator& GetSeparator() const { return Separator; }
+
+protected:
+    UPROPERTY()
+    UAudioAnalysisToolsLibrary* AATools = nullptr;
+
+    float BinHz = 0.f;
+    float LastProcessMs = 0.f;
+
+    FHarmonicPercussiveSeparator Separator;
+};
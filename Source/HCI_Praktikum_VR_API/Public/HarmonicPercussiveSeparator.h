@@ -0,0 +1,63 @@
+// HarmonicPercussiveSeparator.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SlidingMedian.h"
+
+/**
+ * Streaming median-filter harmonic/percussive separation (Fitzgerald 2010).
+ *
+ * Per hop, the harmonic estimate of every bin is the median of that bin over the
+ * last HarmonicWindow frames (causal, so it lags by HarmonicWindow/2 hops), and
+ * the percussive estimate is the median over PercussiveWindow neighbouring bins
+ * of the current frame. Both use sliding medians, i.e. O(log k) per bin.
+ * The estimates are turned into soft Wiener masks that sum to one.
+ */
+class HCI_PRAKTIKUM_VR_API_API FHarmonicPercussiveSeparator
+{
+public:
+    void Init(int32 InNumBins, int32 InHarmonicWindow, int32 InPercussiveWindow, float InMaskPower = 2.f, float InBinHz = 0.f);
+    void Reset();
+
+    /** Separate one magnitude frame of NumBins values. */
+    void Process(const float* Magnitudes);
+
+    bool IsInitialized() const { return NumBins > 0; }
+    int32 GetNumBins() const { return NumBins; }
+
+    const TArray<float>& GetHarmonicSpectrum() const { return Harmonic; }
+    const TArray<float>& GetPercussiveSpectrum() const { return Percussive; }
+    const TArray<float>& GetHarmonicMask() const { return HarmonicMask; }
+
+    /** Percussive mask is 1 - harmonic mask, materialized for consumers that want an array. */
+    const TArray<float>& GetPercussiveMask() const { return PercussiveMask; }
+
+    /** Mean squared magnitude of the separated spectra. */
+    float GetHarmonicEnergy() const { return HarmonicEnergy; }
+    float GetPercussiveEnergy() const { return PercussiveEnergy; }
+
+    /** Positive spectral flux of the percussive part, a clean onset signal for drums. */
+    float GetPercussiveFlux() const { return PercussiveFlux; }
+
+    /** Spectral centroid of the harmonic part in Hz (0 if no bin width was given). */
+    float GetHarmonicCentroidHz() const { return HarmonicCentroidHz; }
+
+private:
+    int32 NumBins = 0;
+    int32 PercussiveHalf = 0;
+    float MaskPower = 2.f;
+    float BinHz = 0.f;
+
+    FSlidingMedianBank TimeMedians;  // one channel per bin
+    FSlidingMedianBank FreqMedian;   // single channel, reset per frame
+
+    TArray<float> HarmonicEstimate, PercussiveEstimate;
+    TArray<float> Harmonic, Percussive;
+    TArray<float> HarmonicMask, PercussiveMask;
+
+    float HarmonicEnergy = 0.f;
+    float PercussiveEnergy = 0.f;
+    float PercussiveFlux = 0.f;
+    float HarmonicCentroidHz = 0.f;
+};
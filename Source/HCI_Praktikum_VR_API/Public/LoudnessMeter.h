@@ -0,0 +1,77 @@
+// LoudnessMeter.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+
+/**
+ * ITU-R BS.1770 / EBU R128 loudness meter.
+ *
+ * K-weighting (high shelf + RLB high-pass) runs as two cascaded biquads with one
+ * channel per SIMD lane, so up to four channels cost the same as one. Energy is
+ * accumulated in 100 ms sub-blocks; momentary (400 ms) and short-term (3 s)
+ * loudness are sliding sums over those sub-blocks, and the integrated value uses
+ * the standard absolute (-70 LUFS) and relative (-10 LU) gates over a fixed
+ * 0.1 LU histogram, so memory stays constant for any song length.
+ */
+class HCI_PRAKTIKUM_VR_API_API FLoudnessMeter
+{
+public:
+    static constexpr int32 MaxChannels = 4;
+    static constexpr float SilenceLufs = -120.0f;
+
+    void Init(float InSampleRate, int32 InNumChannels);
+    void Reset();
+
+    /** Feed interleaved samples. Cheap per call: per-sample filtering plus O(1) work per finished sub-block. */
+    void Process(const float* Interleaved, int32 NumFrames);
+
+    float GetMomentaryLufs() const { return MomentaryLufs; }
+    float GetShortTermLufs() const { return ShortTermLufs; }
+
+    /** Gated integrated loudness since the last Reset(). Evaluated lazily from the histogram. */
+    float GetIntegratedLufs() const;
+
+    bool IsInitialized() const { return NumChannels > 0; }
+    float GetSampleRate() const { return SampleRate; }
+    int32 GetNumChannels() const { return NumChannels; }
+
+private:
+    struct FBiquadCoefs
+    {
+        VectorRegister4Float B0, B1, B2, A1, A2;
+    };
+
+    static constexpr int32 SubBlocksMomentary = 4;   // 4 x 100 ms
+    static constexpr int32 SubBlocksShortTerm = 30;  // 30 x 100 ms
+    static constexpr float HistogramMinLufs = -70.0f;
+    static constexpr float HistogramStepLu = 0.1f;
+    static constexpr int32 HistogramBins = 1000;     // -70 .. +30 LUFS
+
+    float SampleRate = 0.0f;
+    int32 NumChannels = 0;
+    int32 SubBlockLength = 0;
+
+    FBiquadCoefs Shelf;
+    FBiquadCoefs HighPass;
+    VectorRegister4Float ShelfZ1, ShelfZ2, HighPassZ1, HighPassZ2;
+
+    VectorRegister4Float SubBlockSum;
+    int32 SubBlockFill = 0;
+
+    /** Mean-square energy (channel-weighted sum) of the last SubBlocksShortTerm sub-blocks. */
+    float SubBlockEnergy[SubBlocksShortTerm] = {};
+    int32 SubBlockHead = 0;
+    int32 SubBlocksSeen = 0;
+
+    float MomentaryLufs = SilenceLufs;
+    float ShortTermLufs = SilenceLufs;
+
+    uint32 HistogramCounts[HistogramBins] = {};
+
+    static FBiquadCoefs MakeCoefs(double B0, double B1, double B2, double A1, double A2);
+    void FinishSubBlock();
+
+    static float EnergyToLufs(double Energy);
+};
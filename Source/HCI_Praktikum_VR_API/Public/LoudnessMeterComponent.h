@@ -0,0 +1,91 @@
+// LoudnessMeterComponent.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "LoudnessMeter.h"
+#include "LoudnessMeterComponent.generated.h"
+
+class UAudioComponent;
+
+/**
+ * Perceptual loudness (LUFS) per analysis hop, as a stable alternative to the
+ * plugin's RMS. Feed it the same frames that go into ProcessAudioFrames on the
+ * AudioAnalysisTools instance.
+ */
+UCLASS(ClassGroup = Audio, meta = (BlueprintSpawnableComponent))
+class HCI_PRAKTIKUM_VR_API_API ULoudnessMeterComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    ULoudnessMeterComponent();
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Loudness")
+    float SampleRate = 48000.f;
+
+    /** Interleaved channel count of the frames passed to ProcessAudioFrames (1..4). A change re-configures the meter on the next call. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Loudness", meta = (ClampMin = "1", ClampMax = "4"))
+    int32 NumChannels = 2;
+
+    /** Loudness mapped to 0 by GetLoudnessFeature. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Loudness")
+    float FeatureFloorLufs = -50.f;
+
+    /** Loudness mapped to 1 by GetLoudnessFeature. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Loudness")
+    float FeatureCeilingLufs = -8.f;
+
+    /** Target for automatic gain normalization. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Loudness|Normalization")
+    float TargetLufs = -16.f;
+
+    /** Upper bound for the normalization gain in dB (both directions). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Loudness|Normalization")
+    float MaxNormalizationDb = 12.f;
+
+    /** How fast the normalization gain may move, in dB per second of audio. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Loudness|Normalization")
+    float NormalizationSlewDbPerSecond = 3.f;
+
+    /** If set, the normalization gain is applied as volume multiplier after every processed hop. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Loudness|Normalization")
+    TObjectPtr<UAudioComponent> NormalizationTarget;
+
+    /** Re-initialize the filters for a new format and clear all history. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Loudness")
+    void Configure(float InSampleRate, int32 InNumChannels);
+
+    /** Clear loudness history (e.g. at song start) without changing the format. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Loudness")
+    void ResetMeter();
+
+    /** Feed one hop of interleaved samples. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Loudness")
+    void ProcessAudioFrames(const TArray<float>& AudioFrames);
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Loudness")
+    float GetMomentaryLufs() const { return Meter.GetMomentaryLufs(); }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Loudness")
+    float GetShortTermLufs() const { return Meter.GetShortTermLufs(); }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Loudness")
+    float GetIntegratedLufs() const { return Meter.GetIntegratedLufs(); }
+
+    /** Momentary loudness mapped linearly from [FeatureFloorLufs, FeatureCeilingLufs] to [0, 1]. */
+    UFUNCTION(BlueprintPure, Category = "Audio|Loudness")
+    float GetLoudnessFeature() const;
+
+    /** Current (slewed) linear gain that moves short-term loudness towards TargetLufs. */
+    UFUNCTION(BlueprintPure, Category = "Audio|Loudness|Normalization")
+    float GetNormalizationGain() const { return FMath::Pow(10.f, NormalizationDb / 20.f); }
+
+protected:
+    virtual void BeginPlay() override;
+
+private:
+    FLoudnessMeter Meter;
+    float NormalizationDb = 0.f;
+};
@@ -5,8 +5,31 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "AudioAnalysisToolsLibrary.h"
+#include "MelOverbandProcessor.h"
+#include "BandpassFilterBank.h"
 #include "MelOverbandAnalyzerComponent.generated.h"
 
+class UHarmonicPercussiveComponent;
+
+/** Which spectrum the over-bands are computed from. */
+UENUM(BlueprintType)
+enum class EOverbandSpectrumSource : uint8
+{
+    Mixed       UMETA(DisplayName = "Mixed"),
+    Harmonic    UMETA(DisplayName = "Harmonic"),
+    Percussive  UMETA(DisplayName = "Percussive")
+};
+
+/** Where the raw band levels come from. */
+UENUM(BlueprintType)
+enum class EOverbandBackend : uint8
+{
+    /** Mean FFT magnitude per band from AudioAnalysisTools. */
+    FFT         UMETA(DisplayName = "FFT"),
+    /** Time-domain biquad bandpass bank fed via PushAudioSamples; sub-frame latency, no FFT. */
+    FilterBank  UMETA(DisplayName = "Filter Bank")
+};
+
 /**
  *  Consumes an existing UAudioAnalysisToolsLibrary FFT,
  *  groups into Mel‑spaced over‑bands, applies envelope/peak tracking,
@@ -21,7 +44,10 @@ class HCI_PRAKTIKUM_VR_API_API UMelOverbandAnalyzerComponent : public UActorComp
 public:
     UMelOverbandAnalyzerComponent();
 
-    /** Bind this component to your Blueprint’s AudioAnalysisToolsLibrary instance. */
+    /**
+     * Bind this component to your Blueprint’s AudioAnalysisToolsLibrary instance.
+     * InAnalyzer may be null when only the filter-bank backend is used.
+     */
     UFUNCTION(BlueprintCallable, Category = "Audio|Analyzer")
     void SetAnalyzer(
         UAudioAnalysisToolsLibrary* InAnalyzer,
@@ -33,10 +59,60 @@ public:
         float InLogScaleG,
         float InThreshAlpha);
 
+    /** Attack and output smoothing coefficients (defaults 0.8 / 0.9), e.g. from an analyzer sweep. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Analyzer")
+    void SetSmoothingCoefficients(float InAttackCoef, float InVisSmoothAlpha);
+
+    /**
+     * Choose how band envelopes are normalized. Quantile maps between the Low and High
+     * quantiles of the recent envelope (Decay per frame), so single transients do not
+     * squash a band.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Analyzer")
+    void SetNormalization(EOverbandNormalization InMode, float InLowQuantile = 0.05f, float InHighQuantile = 0.95f, float InDecay = 0.999f);
+
+    /**
+     * Change FFT frame size and band count at runtime (quality tiers). Unlike
+     * SetAnalyzer, envelope/peak/threshold state is resampled onto the new bands
+     * instead of being reset. Re-init AATools with the same frame size. Only valid
+     * after SetAnalyzer; a call that changes neither size is a no-op.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Analyzer")
+    void Reconfigure(int32 InFrameSize, int32 InOverBandCount);
+
+    /** True once SetAnalyzer has provided a sample rate. */
+    UFUNCTION(BlueprintPure, Category = "Audio|Analyzer")
+    bool IsInitialized() const { return SampleRate > 0.f; }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Analyzer")
+    int32 GetOverBandCount() const { return OverBandCount; }
+
+    /** CPU time of the last Process call in ms. */
+    UFUNCTION(BlueprintPure, Category = "Audio|Analyzer")
+    float GetLastProcessMs() const { return LastProcessMs; }
+
+    /** Band values written by the last Process call (empty before the first). */
+    const TArray<float>& GetLastOutput() const { return Processor.GetLastOutput(); }
+
+    /** Switch between FFT band averages and the time-domain filter bank. Envelope state is kept. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Analyzer")
+    void SetBackend(EOverbandBackend InBackend);
+
+    /** Filter-bank backend: feed interleaved samples (any block size) before Process. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Analyzer")
+    void PushAudioSamples(const TArray<float>& AudioFrames, int32 NumChannels = 1);
+
     /** After AATools->ProcessAudioFrames(...), call each tick to fill OutVis. */
     UFUNCTION(BlueprintCallable, Category = "Audio|Analyzer")
     void Process(TArray<float>& OutVis);
 
+    /**
+     * Route a separated spectrum into this analyzer instead of the mixed one.
+     * The separator must be processed before this component each hop.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Analyzer")
+    void SetSpectrumSource(UHarmonicPercussiveComponent* InSeparator, EOverbandSpectrumSource InSource);
+
     /** Enable per‑frame CSV dumping to Saved/ folder. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
     bool bDebugToCSV = false;
@@ -50,27 +126,31 @@ protected:
     UPROPERTY()
     UAudioAnalysisToolsLibrary* AATools = nullptr;
 
+    UPROPERTY()
+    UHarmonicPercussiveComponent* Separator = nullptr;
+
+    EOverbandSpectrumSource SpectrumSource = EOverbandSpectrumSource::Mixed;
+
+    EOverbandBackend Backend = EOverbandBackend::FFT;
+    FBandpassFilterBank FilterBank;
+    TArray<float> MonoScratch;
+
     // Derived from FrameSize/SampleRate
     int32 SubBandCount = 0;
     float SampleRate = 0.f;
 
     // Configured in SetAnalyzer()
     int32 OverBandCount = 0;
-    float DecayEnv = 0.85f;       // release
-    float DecayPeak = 0.90f;
-    float LogScaleG = 1000.f;
-    float ThreshAlpha = 0.99f;
-
-    // Attack coefficient (0–1, larger → slower attack)
-    float AttackCoef = 0.8f;
+    FMelOverbandParams Params;
 
-    // Exponential smoothing α for final OutVis (0–1, larger → smoother)
-    float VisSmoothAlpha = 0.9f;
+    // Per-band stages and their state
+    FMelOverbandProcessor Processor;
 
-    // State arrays
     TArray<int32>   BandEdges;
-    TArray<float>   EnvBuf, PeakBuf, ThrBuf;
-    TArray<float>   LastVis;
+    TArray<float>   RawAvgBuf;
+    TArray<FMelOverbandStageValues> DebugStages;
+
+    float LastProcessMs = 0.f;
 
     // Debug CSV
     FString DebugCSVBuffer;
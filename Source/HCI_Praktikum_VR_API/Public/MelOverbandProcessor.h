@@ -0,0 +1,92 @@
+// MelOverbandProcessor.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BandQuantileTracker.h"
+#include "MelOverbandProcessor.generated.h"
+
+/** How the envelope is normalized to 0..1 before the log-warp. */
+UENUM(BlueprintType)
+enum class EOverbandNormalization : uint8
+{
+    /** env / decaying peak; one loud transient squashes the band until the peak has decayed. */
+    DecayingPeak    UMETA(DisplayName = "Decaying Peak"),
+    /** Linear map between streaming low and high quantiles of the envelope; robust to outliers. */
+    Quantile        UMETA(DisplayName = "Quantile")
+};
+
+/** Tuning constants of the over-band pipeline. */
+struct FMelOverbandParams
+{
+    float DecayEnv = 0.85f;        // envelope release
+    float DecayPeak = 0.90f;
+    float LogScaleG = 1000.f;
+    float ThreshAlpha = 0.99f;
+    float AttackCoef = 0.8f;       // 0–1, larger → slower attack
+    float VisSmoothAlpha = 0.9f;   // 0–1, larger → smoother output
+
+    EOverbandNormalization Normalization = EOverbandNormalization::DecayingPeak;
+    float QuantileLow = 0.05f;
+    float QuantileHigh = 0.95f;
+    float QuantileDecay = 0.999f;  // per frame; 0.999 ≈ 15 s memory at 72 fps
+};
+
+/** Intermediate values of one band for debugging. */
+struct FMelOverbandStageValues
+{
+    float Env = 0.f;
+    float Peak = 0.f;
+    float Norm = 0.f;
+    float Warped = 0.f;
+    float Thr = 0.f;
+    float AdjRaw = 0.f;
+};
+
+/**
+ * The per-band stages of UMelOverbandAnalyzerComponent without any UObject or
+ * plugin dependency: envelope, peak tracking, log-warp, adaptive threshold and
+ * output smoothing. Shared by the live component and offline tools, so both
+ * produce bit-identical results for the same input.
+ */
+class HCI_PRAKTIKUM_VR_API_API FMelOverbandProcessor
+{
+public:
+    /** Mel-spaced band edges into a spectrum of NumBins bins covering 0..SampleRate/2. */
+    static void ComputeBandEdges(int32 NumBins, float SampleRate, int32 OverBandCount, TArray<int32>& OutEdges);
+
+    /** The same Mel spacing as frequencies in Hz (OverBandCount + 1 values from 0 to SampleRate/2). */
+    static void ComputeBandEdgesHz(float SampleRate, int32 OverBandCount, TArray<float>& OutEdgesHz);
+
+    /** Mean magnitude of each band. OutAverages needs Edges.Num() - 1 entries. */
+    static void ComputeBandAverages(const float* Magnitudes, const TArray<int32>& Edges, float* OutAverages);
+
+    void Init(int32 InOverBandCount, const FMelOverbandParams& InParams);
+    void Reset();
+
+    /**
+     * Change the band count without losing state: envelope, peak, threshold and
+     * output are interpolated over the relative band position, so visuals do not
+     * jump when the quality tier changes.
+     */
+    void ResizeBands(int32 InOverBandCount);
+
+    void SetParams(const FMelOverbandParams& InParams);
+    const FMelOverbandParams& GetParams() const { return Params; }
+    int32 GetBandCount() const { return OverBandCount; }
+
+    /** Run one frame of band averages through all stages. OutStages is optional (per band). */
+    void Process(const float* RawAverages, float* OutVis, FMelOverbandStageValues* OutStages = nullptr);
+
+    const TArray<float>& GetLastOutput() const { return LastVis; }
+
+private:
+    int32 OverBandCount = 0;
+    FMelOverbandParams Params;
+    float InvLogDen = 0.f;
+
+    TArray<float> EnvBuf, PeakBuf, ThrBuf;
+    TArray<float> LastVis;
+
+    FBandQuantileTracker Quantiles;
+};
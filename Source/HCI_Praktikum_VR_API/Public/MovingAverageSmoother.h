@@ -0,0 +1,82 @@
+// MovingAverageSmoother.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "MovingAverageSmoother.generated.h"
+
+/**
+ * Moving average over the last WindowSize samples in a fixed ring buffer.
+ * The running sum is Kahan-compensated, so it does not drift over long
+ * sessions. Update is O(1) and does not allocate. Until the window is full the
+ * mean is taken over the samples seen so far, like SMA_Smooth.
+ */
+struct HCI_PRAKTIKUM_VR_API_API FMovingAverageWindow
+{
+    void Init(int32 InWindowSize);
+    void Reset();
+
+    /** Add a sample, dropping the oldest one when full; returns the new mean. */
+    float Update(float NewSample);
+
+    float GetMean() const { return Count > 0 ? float(Sum / Count) : 0.f; }
+    int32 GetCount() const { return Count; }
+    int32 GetWindowSize() const { return Samples.Num(); }
+
+    /** Samples oldest first. */
+    void GetSamples(TArray<float>& OutSamples) const;
+
+private:
+    void Accumulate(double Value);
+
+    TArray<float> Samples;
+    int32 Head = 0;   // next write position
+    int32 Count = 0;
+    double Sum = 0.0;
+    double Compensation = 0.0;
+};
+
+/**
+ * Blueprint handle for FMovingAverageWindow, replacing SMA_Smooth and the
+ * array it needs to carry between calls. Migration: create once with the
+ * same WindowSize, optionally Seed it with the stored buffer, then call
+ * Update(NewSample) where SMA_Smooth was called.
+ */
+UCLASS(BlueprintType)
+class HCI_PRAKTIKUM_VR_API_API UMovingAverageSmoother : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    static UMovingAverageSmoother* CreateMovingAverageSmoother(int32 WindowSize);
+
+    /** Add a sample and return the mean of the window. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    float Update(float NewSample);
+
+    /** Replace the history with the newest WindowSize values of Buffer (oldest first), e.g. an SMA_Smooth buffer. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    void Seed(const TArray<float>& Buffer);
+
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    void Reset() { Window.Reset(); }
+
+    /** Changes the window length; the newest samples are kept. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    void SetWindowSize(int32 WindowSize);
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Smoothing")
+    float GetMean() const { return Window.GetMean(); }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Smoothing")
+    int32 GetWindowSize() const { return Window.GetWindowSize(); }
+
+    /** Current window contents, oldest first (allocates; for debugging). */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    void GetSamples(TArray<float>& OutSamples) const { Window.GetSamples(OutSamples); }
+
+private:
+    FMovingAverageWindow Window;
+};
@@ -0,0 +1,108 @@
+// NiagaraBandArrayUploaderComponent.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "NiagaraBandArrayUploaderComponent.generated.h"
+
+class UNiagaraComponent;
+class UMelOverbandAnalyzerComponent;
+class UFeatureSmoothingComponent;
+
+/**
+ * Uploads the over-band vector and a per-band feature matrix into Niagara
+ * float-array data interfaces (User parameters of type "Array Float"), one
+ * call per array and target per frame. Emitters index the arrays per particle,
+ * e.g. Band = ExecIndex % NumBands, instead of reading dozens of scalar
+ * parameters.
+ *
+ * The matrix is row-major: element [Feature * NumBands + Band]. Staging arrays
+ * are kept between frames and nothing is uploaded when the data did not change.
+ */
+UCLASS(ClassGroup = Audio, meta = (BlueprintSpawnableComponent))
+class HCI_PRAKTIKUM_VR_API_API UNiagaraBandArrayUploaderComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UNiagaraBandArrayUploaderComponent();
+
+    /** Array Float user parameter receiving the over-band vector; None = skip. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Niagara|Band Arrays")
+    FName BandArrayParameter = TEXT("User.BandValues");
+
+    /** Array Float user parameter receiving the feature matrix; None = skip. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Niagara|Band Arrays")
+    FName FeatureMatrixParameter = TEXT("User.BandFeatures");
+
+    /** Int user parameter receiving the band count; None = skip. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Niagara|Band Arrays")
+    FName NumBandsParameter = TEXT("User.NumBands");
+
+    /** Rows of the feature matrix, read from FeatureSource in this order. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Niagara|Band Arrays")
+    TArray<FName> MatrixFeatures;
+
+    /** Read the analyzer / smoothing outputs and upload every tick. Off: call Upload yourself. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Niagara|Band Arrays")
+    bool bAutoUpload = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Niagara|Band Arrays")
+    TArray<TObjectPtr<UNiagaraComponent>> TargetComponents;
+
+    /** Actors whose Niagara components also receive the arrays (via the target registry). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Niagara|Band Arrays")
+    TArray<FString> TargetActorNameSubstrings;
+
+    /** Source of the over-band vector; found on the owner if not set. */
+    UFUNCTION(BlueprintCallable, Category = "Niagara|Band Arrays")
+    void SetAnalyzer(UMelOverbandAnalyzerComponent* InAnalyzer) { Analyzer = InAnalyzer; }
+
+    /** Source of the matrix rows; found on the owner if not set. */
+    UFUNCTION(BlueprintCallable, Category = "Niagara|Band Arrays")
+    void SetFeatureSource(UFeatureSmoothingComponent* InFeatureSource) { FeatureSource = InFeatureSource; }
+
+    /** Stage the band vector by hand (instead of an analyzer). */
+    UFUNCTION(BlueprintCallable, Category = "Niagara|Band Arrays")
+    void SetBandValues(const TArray<float>& Values);
+
+    /** Stage one matrix row by hand; the row is padded or cut to the band count. */
+    UFUNCTION(BlueprintCallable, Category = "Niagara|Band Arrays")
+    void SetFeatureRow(int32 Row, const TArray<float>& Values);
+
+    /** Pull from the sources (if any) and push changed arrays to all targets. */
+    UFUNCTION(BlueprintCallable, Category = "Niagara|Band Arrays")
+    void Upload();
+
+    /** Next Upload pushes even unchanged data, e.g. after adding targets. */
+    UFUNCTION(BlueprintCallable, Category = "Niagara|Band Arrays")
+    void MarkDirty() { bDirty = true; }
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+    void PullSources();
+    void GatherTargets();
+    static bool CopyIfChanged(const float* Source, int32 Num, TArray<float>& Dest);
+
+    UPROPERTY()
+    TObjectPtr<UMelOverbandAnalyzerComponent> Analyzer;
+
+    UPROPERTY()
+    TObjectPtr<UFeatureSmoothingComponent> FeatureSource;
+
+    TArray<float> BandValues;
+    TArray<float> FeatureMatrix;
+    int32 NumBands = 0;
+    int32 UploadedNumBands = INDEX_NONE;
+
+    TArray<TWeakObjectPtr<UNiagaraComponent>> Targets;
+    uint32 TargetRevision = MAX_uint32;
+
+    bool bBandsChanged = false;
+    bool bMatrixChanged = false;
+    bool bDirty = true;
+};
@@ -0,0 +1,59 @@
+// NiagaraParameterBindings.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NiagaraTypes.h"
+#include "UObject/ObjectKey.h"
+
+class UNiagaraComponent;
+class UNiagaraSystem;
+
+/**
+ * A fixed list of float user parameters pushed to many Niagara components.
+ *
+ * Each parameter name is turned into an FNiagaraVariable once. Per component,
+ * the variables are resolved to offsets in the override parameter store the
+ * first time the component is seen (and again when its system asset or
+ * parameter layout changes). A shadow copy of the last pushed values is kept,
+ * so Push only writes parameters that moved by more than the epsilon, back to
+ * back into the same store.
+ *
+ * Parameters the system does not expose are skipped silently. Writes made to
+ * the component by other code are not seen; call Invalidate to force a full
+ * push after that.
+ */
+class HCI_PRAKTIKUM_VR_API_API FNiagaraFloatParameterBindings
+{
+public:
+    /** Names may be given with or without the "User." prefix. */
+    void Init(TConstArrayView<FName> ParameterNames);
+
+    /**
+     * Write Values (one per parameter, in Init order) to Component.
+     * Returns the number of parameters actually written.
+     */
+    int32 Push(UNiagaraComponent* Component, TConstArrayView<float> Values, float Epsilon = 1e-4f);
+
+    /** Forget the shadow values of one component (nullptr: all components). */
+    void Invalidate(UNiagaraComponent* Component = nullptr);
+
+    /** Drop cached bindings of components that no longer exist. */
+    void PruneStale();
+
+    int32 Num() const { return Variables.Num(); }
+
+private:
+    struct FComponentBinding
+    {
+        TWeakObjectPtr<const UNiagaraSystem> System;
+        int32 LayoutSize = INDEX_NONE;
+        TArray<int32> Offsets;  // INDEX_NONE for parameters the system lacks
+        TArray<float> Shadow;   // last value written, NaN = never written
+    };
+
+    void Resolve(UNiagaraComponent* Component, FComponentBinding& Binding) const;
+
+    TArray<FNiagaraVariable> Variables;
+    TMap<TObjectKey<UNiagaraComponent>, FComponentBinding> Bindings;
+};
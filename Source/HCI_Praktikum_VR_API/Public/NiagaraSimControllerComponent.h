@@ -2,11 +2,37 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "NiagaraParameterBindings.h"
 #include "NiagaraSimControllerComponent.generated.h"
 
 class UNiagaraComponent;
+class UNiagaraSimValueProvider;
 class AActor;
 
+/** Drives one Sim_… or default_… property from a provider in realtime mode. */
+USTRUCT(BlueprintType)
+struct FNiagaraSimValueBinding
+{
+    GENERATED_BODY()
+
+    /** Name of the float property on the controller to drive */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Binding", meta = (GetOptions = "GetBindablePropertyNames"))
+    FName Property;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Instanced, Category = "Binding")
+    TObjectPtr<UNiagaraSimValueProvider> Provider;
+
+    /** Property = Provider * Scale + Offset */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Binding")
+    float Scale = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Binding")
+    float Offset = 0.0f;
+
+    /** Resolved at BeginPlay */
+    FFloatProperty* ResolvedProperty = nullptr;
+};
+
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class HCI_PRAKTIKUM_VR_API_API UNiagaraSimControllerComponent : public UActorComponent
 {
@@ -17,6 +43,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 public:
     // --- Simulation Parameters (for Niagara systems) ---
@@ -84,13 +111,34 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Niagara Simulation|Statistics")
     float default_EnergyDifference = 0.0f;
 
+    /** Sim_… values closer than this to the last pushed value are not re‑sent **/
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Niagara Simulation", meta = (ClampMin = "0.0"))
+    float ParameterEpsilon = 1e-4f;
+
+    // --- Realtime mode ---
+
+    /** Tick, evaluate ValueBindings and push whatever changed **/
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Niagara Simulation|Realtime")
+    bool bRealtimeUpdate = false;
+
+    /** Updates per second; 0 = every frame **/
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Niagara Simulation|Realtime", meta = (ClampMin = "0.0", EditCondition = "bRealtimeUpdate"))
+    float UpdateRateHz = 30.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Niagara Simulation|Realtime", meta = (EditCondition = "bRealtimeUpdate"))
+    TEnumAsByte<ETickingGroup> RealtimeTickGroup = TG_PrePhysics;
+
+    /** Live sources for Sim_… / default_… values **/
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Niagara Simulation|Realtime", meta = (EditCondition = "bRealtimeUpdate"))
+    TArray<FNiagaraSimValueBinding> ValueBindings;
+
     // --- Manual targets & search strings ---
 
     /** Drag‑and‑drop any actor whose NiagaraComponents you want to update **/
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Niagara Targets")
     TArray<TObjectPtr<AActor>> TargetNiagaraActors;
 
-    /** Partial actor‑name matches to pick up additional NiagaraComponents **/
+    /** Partial actor‑name matches to pick up additional NiagaraComponents (resolved via UNiagaraTargetRegistrySubsystem) **/
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Niagara Targets")
     TArray<FString> TargetNiagaraActorNameSubstrings;
 
@@ -119,4 +167,49 @@ public:
     /** Calls both of the above in one go */
     UFUNCTION(CallInEditor, BlueprintCallable, Category = "Niagara Simulation")
     void ApplyAllParameters();
+
+    /** Start or stop realtime mode at runtime **/
+    UFUNCTION(BlueprintCallable, Category = "Niagara Simulation|Realtime")
+    void SetRealtimeUpdate(bool bEnable, float InUpdateRateHz = 30.0f);
+
+    /** Re‑resolve ValueBindings after changing them at runtime **/
+    UFUNCTION(BlueprintCallable, Category = "Niagara Simulation|Realtime")
+    void InitializeValueBindings();
+
+    UFUNCTION()
+    static TArray<FString> GetBindablePropertyNames();
+
+private:
+    static constexpr int32 NumSimParameters = 13;
+    static constexpr int32 NumStatisticParameters = 8;
+
+    void GatherSimValues(float* OutValues) const;
+    void GatherStatisticValues(float* OutValues) const;
+
+    /** Copies Current into Last and returns true if any value moved by more than ParameterEpsilon */
+    bool ConsumeChanges(const float* Current, float* Last, int32 Num) const;
+
+    /** Byte offsets of the default_… properties on one firefly class */
+    struct FStatisticPropertyTable
+    {
+        struct FSlot
+        {
+            int32 Offset = INDEX_NONE;
+            bool bDouble = false;
+        };
+        FSlot Slots[NumStatisticParameters];
+    };
+
+    const FStatisticPropertyTable& GetStatisticPropertyTable(UClass* Cls);
+
+    /** Keyed weakly, so reinstanced Blueprint classes get a fresh table */
+    TMap<TObjectKey<UClass>, FStatisticPropertyTable> StatisticPropertyTables;
+
+    float RealtimeSeconds = 0.0f;
+    uint32 LastRegistryRevision = 0;
+    float LastSimValues[NumSimParameters];
+    float LastStatisticValues[NumStatisticParameters];
+
+    /** User.Sim_… offsets and last pushed values per NiagaraComponent */
+    FNiagaraFloatParameterBindings SimParameterBindings;
 };
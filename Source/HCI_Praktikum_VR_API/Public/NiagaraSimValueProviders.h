@@ -0,0 +1,110 @@
+// NiagaraSimValueProviders.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Curves/CurveFloat.h"
+#include "NiagaraSimValueProviders.generated.h"
+
+class UActorComponent;
+class USceneComponent;
+class UMelOverbandAnalyzerComponent;
+
+/**
+ * Source of one live value for UNiagaraSimControllerComponent's realtime mode.
+ * Instanced per binding; Initialize runs once at BeginPlay so Evaluate only
+ * reads already-resolved references.
+ */
+UCLASS(Abstract, EditInlineNew, DefaultToInstanced, Blueprintable, BlueprintType, CollapseCategories)
+class HCI_PRAKTIKUM_VR_API_API UNiagaraSimValueProvider : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /** Resolve components relative to the controller's owner. */
+    virtual void Initialize(UActorComponent* Controller) {}
+
+    /** TimeSeconds counts from the start of realtime updates. */
+    UFUNCTION(BlueprintNativeEvent, Category = "Niagara Simulation")
+    float Evaluate(float TimeSeconds, float DeltaSeconds);
+    virtual float Evaluate_Implementation(float TimeSeconds, float DeltaSeconds) { return 0.f; }
+};
+
+/** Value from a curve over time, e.g. a scripted ramp across the visualization. */
+UCLASS(meta = (DisplayName = "Curve"))
+class HCI_PRAKTIKUM_VR_API_API UNiagaraSimCurveProvider : public UNiagaraSimValueProvider
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Curve")
+    FRuntimeFloatCurve Curve;
+
+    /** Wrap time into the curve's key range instead of holding the last key. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Curve")
+    bool bLoop = false;
+
+    virtual float Evaluate_Implementation(float TimeSeconds, float DeltaSeconds) override;
+};
+
+/** One band (or the mean of all bands) of a Mel over-band analyzer's last output. */
+UCLASS(meta = (DisplayName = "Analyzer Band"))
+class HCI_PRAKTIKUM_VR_API_API UNiagaraSimAnalyzerProvider : public UNiagaraSimValueProvider
+{
+    GENERATED_BODY()
+
+public:
+    /** Actor holding the analyzer; empty = the controller's owner. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Analyzer")
+    TObjectPtr<AActor> SourceActor;
+
+    /** Over-band index; -1 averages all bands. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Analyzer", meta = (ClampMin = "-1"))
+    int32 Band = -1;
+
+    virtual void Initialize(UActorComponent* Controller) override;
+    virtual float Evaluate_Implementation(float TimeSeconds, float DeltaSeconds) override;
+
+private:
+    TWeakObjectPtr<UMelOverbandAnalyzerComponent> Analyzer;
+};
+
+UENUM(BlueprintType)
+enum class ENiagaraSimTrackedMeasure : uint8
+{
+    /** cm/s */
+    Speed           UMETA(DisplayName = "Speed"),
+    /** cm from the controller owner's root */
+    DistanceToOwner UMETA(DisplayName = "Distance To Owner"),
+    /** World Z in cm */
+    Height          UMETA(DisplayName = "Height")
+};
+
+/** Motion of a tracked scene component, e.g. a motion controller (hand). */
+UCLASS(meta = (DisplayName = "Tracked Component"))
+class HCI_PRAKTIKUM_VR_API_API UNiagaraSimTrackedComponentProvider : public UNiagaraSimValueProvider
+{
+    GENERATED_BODY()
+
+public:
+    /** Actor holding the component; empty = the controller's owner. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracking")
+    TObjectPtr<AActor> SourceActor;
+
+    /** Component tag to pick, e.g. "LeftHand"; None = the actor's root. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracking")
+    FName ComponentTag;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracking")
+    ENiagaraSimTrackedMeasure Measure = ENiagaraSimTrackedMeasure::Speed;
+
+    virtual void Initialize(UActorComponent* Controller) override;
+    virtual float Evaluate_Implementation(float TimeSeconds, float DeltaSeconds) override;
+
+private:
+    TWeakObjectPtr<USceneComponent> Tracked;
+    TWeakObjectPtr<USceneComponent> OwnerRoot;
+    FVector LastLocation = FVector::ZeroVector;
+    bool bHasLastLocation = false;
+};
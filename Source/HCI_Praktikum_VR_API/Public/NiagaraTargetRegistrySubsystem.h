@@ -0,0 +1,113 @@
+// NiagaraTargetRegistrySubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Engine/EngineBaseTypes.h"
+#include "NiagaraTargetRegistrySubsystem.generated.h"
+
+class AActor;
+class ULevel;
+class UNiagaraComponent;
+
+/**
+ * Index of the actors and Niagara components in one world, for name-based
+ * target lookup without TActorIterator/TObjectIterator scans.
+ *
+ * The index follows actor spawn/destroy and streaming level add/remove.
+ * A name-substring query is answered by one pass over the index the first time
+ * it is asked; the result set is then kept and updated whenever an actor or
+ * component is added or removed, so repeated queries are a single hash lookup.
+ * Matching is case-insensitive, like FString::Contains.
+ *
+ * Actors spawned with SpawnActorDeferred are announced before FinishSpawning
+ * adds their Blueprint components, so they are re-read at the next world tick
+ * or query. Niagara components attached later (e.g. SpawnSystemAttached) are
+ * not seen automatically; register them with RegisterNiagaraComponent or call
+ * RefreshActor.
+ */
+UCLASS()
+class HCI_PRAKTIKUM_VR_API_API UNiagaraTargetRegistrySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UNiagaraTargetRegistrySubsystem* Get(const UObject* WorldContextObject);
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /** Actors whose name contains Substring. */
+    UFUNCTION(BlueprintCallable, Category = "Niagara Targets")
+    void FindActorsByName(const FString& Substring, TArray<AActor*>& OutActors);
+
+    /** Registered Niagara components of actors whose name contains Substring. */
+    UFUNCTION(BlueprintCallable, Category = "Niagara Targets")
+    void FindNiagaraComponentsByActorName(const FString& Substring, TArray<UNiagaraComponent*>& OutComponents);
+
+    /** Registered Niagara components whose own name contains Substring. */
+    UFUNCTION(BlueprintCallable, Category = "Niagara Targets")
+    void FindNiagaraComponentsByName(const FString& Substring, TArray<UNiagaraComponent*>& OutComponents);
+
+    UFUNCTION(BlueprintCallable, Category = "Niagara Targets")
+    void RegisterNiagaraComponent(UNiagaraComponent* Component);
+
+    UFUNCTION(BlueprintCallable, Category = "Niagara Targets")
+    void UnregisterNiagaraComponent(UNiagaraComponent* Component);
+
+    /** Re-read the Niagara components of an actor after components were added or removed. */
+    UFUNCTION(BlueprintCallable, Category = "Niagara Targets")
+    void RefreshActor(AActor* Actor);
+
+    /** Bumped on every change, so callers can cache resolved target lists. */
+    uint32 GetRevision() const { return Revision; }
+
+private:
+    void EnsureSeeded();
+    void RefreshDeferredSpawns();
+    void AddActor(AActor* Actor);
+    void RemoveActor(AActor* Actor);
+    void AddComponent(UNiagaraComponent* Component);
+    void RemoveComponent(const TObjectKey<UNiagaraComponent>& Key);
+
+    void HandleActorSpawned(AActor* Actor);
+    void HandleActorDestroyed(AActor* Actor);
+    void HandleLevelAdded(ULevel* Level, UWorld* World);
+    void HandleLevelRemoved(ULevel* Level, UWorld* World);
+    void HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+    struct FIndexedActor
+    {
+        TWeakObjectPtr<AActor> Actor;
+        FString Name;
+        TArray<TObjectKey<UNiagaraComponent>> Components;
+    };
+
+    struct FIndexedComponent
+    {
+        TWeakObjectPtr<UNiagaraComponent> Component;
+        TObjectKey<AActor> Owner;
+        FString Name;
+    };
+
+    TMap<TObjectKey<AActor>, FIndexedActor> Actors;
+    TMap<TObjectKey<UNiagaraComponent>, FIndexedComponent> Components;
+
+    /** Indexed while still under construction; re-read once FinishSpawning has run. */
+    TArray<TWeakObjectPtr<AActor>> DeferredSpawns;
+
+    // Memoized substring queries, updated incrementally.
+    TMap<FString, TSet<TObjectKey<AActor>>> ActorQueries;
+    TMap<FString, TSet<TObjectKey<UNiagaraComponent>>> ComponentQueries;
+
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle ActorDestroyedHandle;
+    FDelegateHandle LevelAddedHandle;
+    FDelegateHandle LevelRemovedHandle;
+    FDelegateHandle WorldTickStartHandle;
+
+    bool bSeeded = false;
+    uint32 Revision = 0;
+};
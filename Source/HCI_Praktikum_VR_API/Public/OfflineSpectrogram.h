@@ -0,0 +1,40 @@
+// OfflineSpectrogram.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FMappedDecodedPcm;
+
+/**
+ * Magnitude spectrogram of a whole song (mono downmix, Hann window), computed
+ * once and cached next to the decoded PCM so offline tools can re-run the
+ * analyzer stages without touching audio again.
+ */
+struct HCI_PRAKTIKUM_VR_API_API FOfflineSpectrogram
+{
+    int32 FrameSize = 0;
+    int32 HopSize = 0;
+    int32 NumBins = 0;     // FrameSize / 2 + 1
+    int32 NumFrames = 0;
+    float SampleRate = 0.f;
+
+    /** Frame-major magnitudes, NumFrames * NumBins. */
+    TArray<float> Magnitudes;
+
+    const float* GetFrame(int32 Frame) const { return Magnitudes.GetData() + int64(Frame) * NumBins; }
+    float GetFrameRate() const { return HopSize > 0 ? SampleRate / HopSize : 0.f; }
+
+    /** FrameSize must be a power of two. */
+    bool Compute(const FMappedDecodedPcm& Pcm, int32 InFrameSize, int32 InHopSize);
+
+    /** Load <AnalysisCacheDir>/spectrogram_<FrameSize>_<HopSize>.bin or compute and write it. */
+    bool LoadOrCompute(const FString& ContentHash, const FMappedDecodedPcm& Pcm, int32 InFrameSize, int32 InHopSize);
+
+    /** Onset frames by peak picking on log spectral flux. Independent of analyzer settings. */
+    void DetectOnsets(TArray<int32>& OutFrames) const;
+
+private:
+    bool Load(const FString& Path);
+    bool Save(const FString& Path) const;
+};
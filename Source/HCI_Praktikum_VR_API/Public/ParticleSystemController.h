@@ -56,6 +56,11 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VR Interaction")
     float GrabRadius = 100.0f;
 
+    // Proximity grid layer searched for the nearest emitter on grab; TargetNiagaraSystem is registered in it.
+    // The layer is shared by all controllers, so a grab may pick up another controller's emitter.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VR Interaction")
+    FName GrabLayer = "Emitters";
+
     // Name of the spawn rate parameter in the Niagara system
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VR Interaction")
     FString SpawnRateParameterName = "SpawnRate";
@@ -66,4 +71,8 @@ private:
 
     // Initial offset between controller and particle system when grabbed
     FVector GrabOffset;
+
+    // Emitter held since the last grab; may belong to another controller, so TargetNiagaraSystem is left alone
+    UPROPERTY()
+    TObjectPtr<UNiagaraComponent> GrabbedSystem;
 };
\ No newline at end of file
@@ -0,0 +1,95 @@
+// PcmStreamSource.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "DSP/Dsp.h"
+#include "DecodedPcmCache.h"
+#include <atomic>
+
+class IFileHandle;
+class FRunnableThread;
+class FEvent;
+
+/**
+ * Streams a decoded.pcm cache file through a small lock-free ring.
+ *
+ * A worker thread reads fixed-size chunks from disk whenever the playback ring
+ * has room. The audio render thread pops playback samples and copies them into a
+ * second, smaller ring for analysis, so the STFT sees exactly what is audible.
+ * The analysis ring overwrites its oldest samples when it is not drained in
+ * time, so after a hitch the consumer continues with the latest audio.
+ * Resident memory is the two rings plus one chunk, independent of song length.
+ */
+class HCI_PRAKTIKUM_VR_API_API FPcmStreamSource : public FRunnable
+{
+public:
+    FPcmStreamSource(int32 InPlaybackRingSamples, int32 InChunkFrames, int32 InAnalysisRingSamples);
+    virtual ~FPcmStreamSource() override;
+
+    /** Open the cache file and start the reader thread. */
+    bool Open(const FString& CachePath, const FString& ContentHash);
+
+    /** Stop the reader thread and close the file. Safe to call twice. */
+    void Shutdown();
+
+    /** Audio render thread: fill Out with NumSamples interleaved samples, zero-padding on underrun or end. */
+    void ReadPlayback(float* Out, int32 NumSamples);
+
+    /**
+     * Any single consumer thread: pop up to MaxSamples played samples in order, oldest first.
+     * Samples overwritten before they were read are skipped.
+     */
+    int32 ReadAnalysis(float* Out, int32 MaxSamples);
+
+    int32 GetSampleRate() const { return int32(Header.SampleRate); }
+    int32 GetNumChannels() const { return int32(Header.NumChannels); }
+    double GetDurationSeconds() const { return Header.SampleRate ? double(Header.NumFrames) / Header.SampleRate : 0.0; }
+    double GetPlaybackSeconds() const;
+
+    /** True once every sample of the file has been handed to playback. */
+    bool IsFinished() const { return bEndOfFile && PlaybackRing.Num() == 0; }
+
+    int32 GetUnderrunCount() const { return Underruns; }
+
+    /** Bytes held by rings and chunk buffers. */
+    SIZE_T GetAllocatedSize() const;
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override { bStopRequested = true; }
+
+private:
+    const int32 ChunkFrames;
+    const uint32 PlaybackCapacity;
+    const uint32 AnalysisCapacity;
+
+    TUniquePtr<IFileHandle> File;
+    FDecodedPcmHeader Header;
+    int64 TotalSamples = 0;
+    int64 NextSample = 0;   // reader thread only
+
+    Audio::TCircularAudioBuffer<float> PlaybackRing;
+
+    // Overwrite-oldest analysis ring. Counters are total samples pushed; Reserved
+    // runs ahead of Committed while the render thread is writing.
+    TArray<float> AnalysisBuffer;
+    std::atomic<uint64> AnalysisReserved{ 0 };
+    std::atomic<uint64> AnalysisCommitted{ 0 };
+    uint64 AnalysisRead = 0;    // consumer only
+
+    TArray<uint8> ChunkBytes;   // reader thread only
+    TArray<float> ChunkSamples; // reader thread only
+
+    std::atomic<int64> SamplesPlayed{ 0 };
+    std::atomic<int32> Underruns{ 0 };
+    std::atomic<bool> bStopRequested{ false };
+    std::atomic<bool> bEndOfFile{ false };
+
+    FEvent* WakeEvent = nullptr;
+    FRunnableThread* Thread = nullptr;
+
+    bool ReadNextChunk();
+    void PushAnalysis(const float* Samples, int32 Num);
+};
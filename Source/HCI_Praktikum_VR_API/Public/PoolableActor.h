@@ -0,0 +1,32 @@
+// PoolableActor.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "PoolableActor.generated.h"
+
+UINTERFACE(MinimalAPI, Blueprintable)
+class UPoolableActor : public UInterface
+{
+    GENERATED_BODY()
+};
+
+/**
+ * Optional hooks for actors managed by UFireflyPoolSubsystem. The pool already
+ * hides, disables and resets Niagara components and default_… statistics;
+ * implement these for any further per-instance state (timers, materials, ...).
+ */
+class HCI_PRAKTIKUM_VR_API_API IPoolableActor
+{
+    GENERATED_BODY()
+
+public:
+    /** Called after the actor was moved into place and made visible again. */
+    UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Pooling")
+    void OnAcquiredFromPool();
+
+    /** Called before the actor is hidden and parked in the pool. */
+    UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Pooling")
+    void OnReleasedToPool();
+};
@@ -0,0 +1,96 @@
+// ProximityGridSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "SpatialHashGrid.h"
+#include "ProximityGridSubsystem.generated.h"
+
+class USceneComponent;
+
+/**
+ * Named spatial hash layers ("Emitters", "Fireflies", ...) for hand proximity
+ * queries that do not go through physics overlaps. Grab controllers register
+ * their emitters and UFireflyPoolSubsystem its active fireflies; other actors
+ * can join a layer with RegisterActor.
+ *
+ * Registered components are tracked by weak pointer and re-binned once per
+ * frame; only components whose location changed are touched, and staying in
+ * the same cell costs a position write. Destroyed components drop out on the
+ * next tick. Give each layer a cell size close to the radius it is queried
+ * with (the grab radius for emitters).
+ */
+UCLASS()
+class HCI_PRAKTIKUM_VR_API_API UProximityGridSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UProximityGridSubsystem* Get(const UObject* WorldContextObject);
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    UFUNCTION(BlueprintCallable, Category = "Proximity")
+    void SetLayerCellSize(FName Layer, float CellSize);
+
+    /**
+     * Size a shared layer for queries up to QueryRadius. The largest radius
+     * requested so far wins, so the grid is only re-binned when it grows.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Proximity")
+    void RequestLayerCellSize(FName Layer, float QueryRadius);
+
+    UFUNCTION(BlueprintCallable, Category = "Proximity")
+    void RegisterComponent(FName Layer, USceneComponent* Component);
+
+    /** Registers the actor's root component. */
+    UFUNCTION(BlueprintCallable, Category = "Proximity")
+    void RegisterActor(FName Layer, AActor* Actor);
+
+    UFUNCTION(BlueprintCallable, Category = "Proximity")
+    void UnregisterComponent(FName Layer, USceneComponent* Component);
+
+    /** Components of a layer within Radius of Location, unordered. */
+    UFUNCTION(BlueprintCallable, Category = "Proximity")
+    TArray<USceneComponent*> FindInRadius(FName Layer, FVector Location, float Radius) const;
+
+    /** Owners of FindInRadius, without duplicates. */
+    UFUNCTION(BlueprintCallable, Category = "Proximity")
+    TArray<AActor*> FindActorsInRadius(FName Layer, FVector Location, float Radius) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Proximity")
+    USceneComponent* FindNearest(FName Layer, FVector Location, float MaxRadius) const;
+
+    /** Up to K components within MaxRadius, nearest first. */
+    UFUNCTION(BlueprintCallable, Category = "Proximity")
+    TArray<USceneComponent*> FindKNearest(FName Layer, FVector Location, int32 K, float MaxRadius) const;
+
+    UFUNCTION(BlueprintPure, Category = "Proximity")
+    int32 GetLayerNum(FName Layer) const;
+
+    /** Raw grid of a layer for C++ callers; ids map to components through GetComponent. */
+    const FSpatialHashGrid* GetGrid(FName Layer) const;
+    USceneComponent* GetComponent(FName Layer, int32 Id) const;
+
+private:
+    struct FLayer
+    {
+        FSpatialHashGrid Grid;
+        /** Indexed by grid id; null for free ids. */
+        TArray<TWeakObjectPtr<USceneComponent>> Components;
+        /** Map keys of Components, kept so destroyed entries can still be removed from Ids. */
+        TArray<TObjectKey<USceneComponent>> Keys;
+        TMap<TObjectKey<USceneComponent>, int32> Ids;
+        /** Largest RequestLayerCellSize radius; 0 until the first request. */
+        float RequestedCellSize = 0.f;
+    };
+
+    FLayer& GetLayer(FName Layer);
+    void RemoveId(FLayer& Layer, int32 Id);
+
+    TMap<FName, FLayer> Layers;
+};
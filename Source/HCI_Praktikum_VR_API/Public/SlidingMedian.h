@@ -0,0 +1,55 @@
+// SlidingMedian.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A bank of independent running medians over fixed-size windows.
+ *
+ * Each channel keeps its window as a ring buffer plus two indexed heaps that
+ * meet at the median (a max-heap of the lower half and a min-heap of the upper
+ * half). Every slot knows its heap position, so replacing the oldest sample is
+ * one sift of O(log Window) with no allocation. All channels share contiguous
+ * storage, which keeps a per-bin or per-band bank cache friendly.
+ *
+ * Windows are forced to odd length so the median is always a single sample.
+ * A window starts out filled with the reset value, i.e. the first Window/2
+ * outputs lean towards that value.
+ */
+class HCI_PRAKTIKUM_VR_API_API FSlidingMedianBank
+{
+public:
+    /** Allocate NumChannels windows of WindowSize samples (rounded up to odd, min 1). */
+    void Init(int32 InNumChannels, int32 InWindowSize, float FillValue = 0.f);
+
+    /** Refill every window with FillValue. */
+    void Reset(float FillValue = 0.f);
+
+    /** Refill a single channel's window with FillValue. */
+    void ResetChannel(int32 Channel, float FillValue = 0.f);
+
+    /** Replace the oldest sample of one channel and return the new median. */
+    float Push(int32 Channel, float Value);
+
+    /** Push one sample per channel; OutMedians may alias InValues. */
+    void PushAll(const float* InValues, float* OutMedians);
+
+    float GetMedian(int32 Channel) const;
+
+    int32 GetNumChannels() const { return NumChannels; }
+    int32 GetWindowSize() const { return WindowSize; }
+
+private:
+    int32 NumChannels = 0;
+    int32 WindowSize = 0;
+    int32 HalfCount = 0;   // entries per heap
+
+    TArray<float> Values;  // [Channel * WindowSize + Slot]
+    TArray<int32> SlotPos; // slot -> signed heap position, 0 = median
+    TArray<int32> Heap;    // [Channel * WindowSize + HalfCount + Pos] -> slot
+    TArray<int32> NextSlot;
+
+    struct FChannelView;
+    FChannelView MakeView(int32 Channel);
+};
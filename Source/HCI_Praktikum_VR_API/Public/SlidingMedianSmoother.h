@@ -0,0 +1,51 @@
+// SlidingMedianSmoother.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "SlidingMedian.h"
+#include "SlidingMedianSmoother.generated.h"
+
+/**
+ * Running median with any odd window length, for de-spiking features such as
+ * the complex spectral difference. Generalizes Median3_Smooth without sorting:
+ * each update is O(log Window) on preallocated storage. With NumBands > 1 one
+ * UpdateBands call advances an independent median per band.
+ *
+ * Windows start out filled with zeros, so the first Window/2 outputs lean
+ * towards 0 (Median3_Smooth pads with zeros the same way).
+ */
+UCLASS(BlueprintType)
+class HCI_PRAKTIKUM_VR_API_API USlidingMedianSmoother : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /** WindowSize is rounded up to odd (e.g. 5..31). */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    static USlidingMedianSmoother* CreateSlidingMedianSmoother(int32 WindowSize, int32 NumBands = 1);
+
+    /** Single-feature form: push into band 0 and return its median. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    float Update(float NewSample);
+
+    /** One sample per band in, one median per band out (OutMedians may be the same array). */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    void UpdateBands(const TArray<float>& NewSamples, TArray<float>& OutMedians);
+
+    UFUNCTION(BlueprintCallable, Category = "Audio|Smoothing")
+    void Reset(float FillValue = 0.f) { Bank.Reset(FillValue); }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Smoothing")
+    float GetMedian(int32 Band = 0) const;
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Smoothing")
+    int32 GetWindowSize() const { return Bank.GetWindowSize(); }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Smoothing")
+    int32 GetNumBands() const { return Bank.GetNumChannels(); }
+
+private:
+    FSlidingMedianBank Bank;
+};
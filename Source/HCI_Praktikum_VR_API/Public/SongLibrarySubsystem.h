@@ -0,0 +1,187 @@
+// SongLibrarySubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Async/Future.h"
+#include <atomic>
+#include "SongLibrarySubsystem.generated.h"
+
+/** Loudness/level summary computed once per song, used to normalize analysis and playback. */
+USTRUCT(BlueprintType)
+struct FSongNormalizationProfile
+{
+    GENERATED_BODY()
+
+    /** Absolute sample peak over all channels (linear, 0..1). */
+    UPROPERTY(BlueprintReadOnly, Category = "Song Library")
+    float PeakAmplitude = 0.0f;
+
+    /** RMS level over the whole song in dBFS. */
+    UPROPERTY(BlueprintReadOnly, Category = "Song Library")
+    float RmsDb = -120.0f;
+
+    /** Gated integrated loudness (ITU-R BS.1770) in LUFS. */
+    UPROPERTY(BlueprintReadOnly, Category = "Song Library")
+    float IntegratedLufs = -120.0f;
+
+    /** Linear gain that brings the song to the library's target loudness (clamped to avoid clipping). */
+    UPROPERTY(BlueprintReadOnly, Category = "Song Library")
+    float SuggestedGain = 1.0f;
+};
+
+/** One indexed audio file. */
+USTRUCT(BlueprintType)
+struct FSongLibraryEntry
+{
+    GENERATED_BODY()
+
+    /** Absolute path of the audio file. */
+    UPROPERTY(BlueprintReadOnly, Category = "Song Library")
+    FString FilePath;
+
+    /** File name without directory, used for lookups by name. */
+    UPROPERTY(BlueprintReadOnly, Category = "Song Library")
+    FString FileName;
+
+    /** 64-bit xxHash of the file contents as hex string. Keys every cache derived from this song. */
+    UPROPERTY(BlueprintReadOnly, Category = "Song Library")
+    FString ContentHash;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Song Library")
+    int64 FileSize = 0;
+
+    /** File modification time at the moment it was indexed. */
+    UPROPERTY(BlueprintReadOnly, Category = "Song Library")
+    FDateTime ModifiedTime;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Song Library")
+    float DurationSeconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Song Library")
+    int32 SampleRate = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Song Library")
+    int32 NumChannels = 0;
+
+    /** Directory under Saved/ that holds analysis results derived from this song. */
+    UPROPERTY(BlueprintReadOnly, Category = "Song Library")
+    FString AnalysisCacheDir;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Song Library")
+    FSongNormalizationProfile Normalization;
+};
+
+/** Serialized form of the index file. */
+USTRUCT()
+struct FSongLibraryIndexFile
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    int32 Version = 0;
+
+    UPROPERTY()
+    TArray<FSongLibraryEntry> Songs;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSongLibraryIndexed, int32, NumSongs);
+
+/**
+ * Keeps a persistent index of the music folder under Saved/SongLibrary/.
+ * Files are re-hashed and re-analyzed only when size or modification time changed,
+ * and changed files are processed in parallel on the task graph.
+ * Replaces the editor script that scanned the folder for the newest MP3 on every run.
+ */
+UCLASS(Config = Game)
+class HCI_PRAKTIKUM_VR_API_API USongLibrarySubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /** Folder scanned for audio files. Relative paths are resolved against the project directory. */
+    UPROPERTY(Config, BlueprintReadOnly, Category = "Song Library")
+    FString MusicFolder = TEXT("Content/Musik");
+
+    /** Integrated loudness (LUFS) that SuggestedGain normalizes to. */
+    UPROPERTY(Config, BlueprintReadOnly, Category = "Song Library")
+    float TargetLufs = -16.0f;
+
+    /** Store the decoded samples of every (re)processed song as int16 PCM cache, see FDecodedPcmCache. */
+    UPROPERTY(Config, BlueprintReadOnly, Category = "Song Library")
+    bool bWriteDecodedPcmCache = true;
+
+    /** Fired on the game thread after an (incremental) rebuild has finished. */
+    UPROPERTY(BlueprintAssignable, Category = "Song Library")
+    FOnSongLibraryIndexed OnLibraryIndexed;
+
+    /**
+     * Rescan the music folder on a worker thread. Unchanged files are taken from the index.
+     * If a rebuild is already running, another one is queued behind it.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Song Library")
+    void RebuildIndexAsync(bool bForceReprocess = false);
+
+    /** Blocking variant of RebuildIndexAsync. */
+    UFUNCTION(BlueprintCallable, Category = "Song Library")
+    void RebuildIndex(bool bForceReprocess = false);
+
+    UFUNCTION(BlueprintCallable, Category = "Song Library")
+    void SetMusicFolder(const FString& InFolder);
+
+    UFUNCTION(BlueprintPure, Category = "Song Library")
+    bool IsIndexing() const { return bIsIndexing; }
+
+    UFUNCTION(BlueprintPure, Category = "Song Library")
+    TArray<FSongLibraryEntry> GetAllSongs() const { return Songs; }
+
+    /** Look up a song by file name (with or without extension) or by full path. */
+    UFUNCTION(BlueprintCallable, Category = "Song Library")
+    bool FindSong(const FString& NameOrPath, FSongLibraryEntry& OutEntry) const;
+
+    /** Most recently modified song, i.e. what the old folder-scan script picked. */
+    UFUNCTION(BlueprintCallable, Category = "Song Library")
+    bool GetNewestSong(FSongLibraryEntry& OutEntry) const;
+
+    /** Directory for caches derived from the given content hash. */
+    static FString GetAnalysisCacheDir(const FString& ContentHash);
+
+    /** Hash a file's contents the same way the index does. Empty string on read failure. */
+    static FString HashFileContents(const FString& FilePath);
+
+    /** Same hash as HashFileContents for bytes already in memory. */
+    static FString HashBuffer(const uint8* Data, int64 Size);
+
+private:
+    static constexpr int32 IndexVersion = 2;
+
+    TArray<FSongLibraryEntry> Songs;
+    TMap<FString, int32> SongsByPath;
+    TMap<FString, int32> SongsByName;
+
+    std::atomic<bool> bIsIndexing{ false };
+    TFuture<void> IndexingTask;
+
+    /** Rebuild requested while indexing; started from ApplyIndex. Game thread only. */
+    bool bRebuildPending = false;
+    bool bPendingForceReprocess = false;
+
+    FString GetIndexFilePath() const;
+    FString GetResolvedMusicFolder() const;
+
+    void LoadIndex();
+    void SaveIndex() const;
+    void RebuildLookups();
+
+    /** Runs on any thread. Produces the new song list from the folder contents and the previous index. */
+    static TArray<FSongLibraryEntry> BuildIndex(const FString& Folder, const TArray<FSongLibraryEntry>& Previous, float InTargetLufs, bool bWritePcmCache, bool bForceReprocess);
+
+    /** Hash, decode and measure a single file. Returns false if the file could not be read or decoded. */
+    static bool ProcessFile(const FString& FilePath, float InTargetLufs, bool bWritePcmCache, FSongLibraryEntry& InOutEntry);
+
+    void ApplyIndex(TArray<FSongLibraryEntry>&& NewSongs);
+};
@@ -0,0 +1,72 @@
+// SpatialHashGrid.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform grid over unbounded space for proximity queries without physics.
+ *
+ * Items are points with stable integer ids. Cells are hashed by their integer
+ * coordinates, so only occupied cells cost memory. Moving an item that stays in
+ * its cell only updates the stored position; crossing a cell boundary is two
+ * O(1) swaps. Rebuild replaces everything from a position array (id = index),
+ * for sets that change completely every frame.
+ *
+ * Pick the cell size close to the typical query radius (e.g. the grab radius):
+ * a radius query then touches 27 cells or fewer.
+ */
+class HCI_PRAKTIKUM_VR_API_API FSpatialHashGrid
+{
+public:
+    explicit FSpatialHashGrid(float InCellSize = 100.f);
+
+    /** Change the cell size and re-bin all items. */
+    void SetCellSize(float InCellSize);
+    float GetCellSize() const { return CellSize; }
+
+    void Reset();
+
+    /** Replace all items; item i gets id i. */
+    void Rebuild(TConstArrayView<FVector> InPositions);
+
+    int32 Add(const FVector& Position);
+    void Move(int32 Id, const FVector& Position);
+    void Remove(int32 Id);
+
+    bool IsValidId(int32 Id) const { return ItemCell.IsValidIndex(Id) && ItemCell[Id] != InvalidCell; }
+    const FVector& GetPosition(int32 Id) const { return Positions[Id]; }
+
+    /** Number of live items. */
+    int32 Num() const { return Positions.Num() - FreeIds.Num(); }
+
+    /** Ids within Radius of Center, unordered. OutIds is reset first. */
+    void QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutIds) const;
+
+    /** Closest item within MaxRadius, INDEX_NONE if there is none. */
+    int32 FindNearest(const FVector& Center, float MaxRadius) const;
+
+    /** Up to K closest items within MaxRadius, nearest first. */
+    void QueryKNearest(const FVector& Center, int32 K, float MaxRadius, TArray<int32>& OutIds) const;
+
+private:
+    static constexpr uint64 InvalidCell = ~uint64(0);
+
+    FIntVector CellCoord(const FVector& P) const;
+    static uint64 PackCell(const FIntVector& C);
+    void Insert(int32 Id, uint64 Cell);
+    void Unlink(int32 Id);
+
+    /** Visit every item in the cells of one Chebyshev ring around Center's cell. */
+    template <typename FunctorType>
+    void ForEachInRing(const FIntVector& Origin, int32 Ring, FunctorType&& Visit) const;
+
+    float CellSize = 100.f;
+    float InvCellSize = 0.01f;
+
+    TArray<FVector> Positions;
+    TArray<uint64> ItemCell;
+    TArray<int32> SlotInCell;
+    TArray<int32> FreeIds;
+    TMap<uint64, TArray<int32>> Cells;
+};
@@ -0,0 +1,25 @@
+// StreamingPcmSoundWave.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sound/SoundWaveProcedural.h"
+#include "StreamingPcmSoundWave.generated.h"
+
+class FPcmStreamSource;
+
+/** Procedural sound wave that pulls float PCM from an FPcmStreamSource on the audio render thread. */
+UCLASS()
+class HCI_PRAKTIKUM_VR_API_API UStreamingPcmSoundWave : public USoundWaveProcedural
+{
+    GENERATED_BODY()
+
+public:
+    void SetSource(const TSharedPtr<FPcmStreamSource, ESPMode::ThreadSafe>& InSource);
+
+    virtual int32 OnGeneratePCMAudio(TArray<uint8>& OutAudio, int32 NumSamples) override;
+    virtual Audio::EAudioMixerStreamDataFormat::Type GetGeneratedPCMAudioFormat() const override { return Audio::EAudioMixerStreamDataFormat::Float; }
+
+private:
+    TSharedPtr<FPcmStreamSource, ESPMode::ThreadSafe> Source;
+};
@@ -0,0 +1,122 @@
+// StreamingSongComponent.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "StreamingSongComponent.generated.h"
+
+class FPcmStreamSource;
+class UAudioComponent;
+class UStreamingPcmSoundWave;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStreamingSongReady, bool, bSuccess);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStreamingSongFinished);
+
+/**
+ * Plays a song by streaming its decoded PCM cache in small chunks instead of
+ * importing the whole file into an imported sound wave. The same samples are
+ * available for analysis via GetLatestAnalysisFrames, so AudioAnalysisTools sees
+ * what is currently audible. Resident memory is bounded by the ring sizes below.
+ */
+UCLASS(ClassGroup = Audio, meta = (BlueprintSpawnableComponent))
+class HCI_PRAKTIKUM_VR_API_API UStreamingSongComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UStreamingSongComponent();
+
+    /** Playback ring in interleaved samples (65536 floats = 256 KB, ~0.7 s of 48 kHz stereo). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Streaming", meta = (ClampMin = "4096"))
+    int32 PlaybackRingSamples = 65536;
+
+    /** Frames read from disk per chunk. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Streaming", meta = (ClampMin = "256"))
+    int32 ChunkFrames = 2048;
+
+    /** Ring of played samples waiting for analysis, in interleaved samples. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Streaming", meta = (ClampMin = "1024"))
+    int32 AnalysisRingSamples = 16384;
+
+    /** Audio component used for playback. Created on demand if unset. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Streaming")
+    TObjectPtr<UAudioComponent> AudioComponent;
+
+    UPROPERTY(BlueprintAssignable, Category = "Audio|Streaming")
+    FOnStreamingSongReady OnSongReady;
+
+    UPROPERTY(BlueprintAssignable, Category = "Audio|Streaming")
+    FOnStreamingSongFinished OnSongFinished;
+
+    /**
+     * Prepare a song for streaming. Uses the song library hash if the file is indexed.
+     * If no PCM cache exists yet it is created once on a worker thread (this one-time
+     * decode needs the full song in memory). OnSongReady fires on the game thread.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Streaming")
+    void OpenSong(const FString& FilePath);
+
+    /** Start playback from the beginning of the opened song. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Streaming")
+    bool Play();
+
+    UFUNCTION(BlueprintCallable, Category = "Audio|Streaming")
+    void Stop();
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Streaming")
+    bool IsPlaying() const;
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Streaming")
+    bool IsSongReady() const { return !CachePath.IsEmpty(); }
+
+    /** Seconds of audio handed to the mixer since Play(); the clock for audio-synchronous events. */
+    UFUNCTION(BlueprintPure, Category = "Audio|Streaming")
+    float GetPlaybackTimeSeconds() const;
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Streaming")
+    int32 GetSampleRate() const { return SampleRate; }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Streaming")
+    int32 GetNumChannels() const { return NumChannels; }
+
+    UFUNCTION(BlueprintPure, Category = "Audio|Streaming")
+    int32 GetUnderrunCount() const;
+
+    /**
+     * The most recent NumFrames interleaved frames that were played, for
+     * AATools->ProcessAudioFrames. Returns false until enough audio has played.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Audio|Streaming")
+    bool GetLatestAnalysisFrames(int32 NumFrames, TArray<float>& OutFrames);
+
+    /** Content hash of the open song (key of its analysis cache), empty while none is ready. */
+    const FString& GetContentHash() const { return ContentHash; }
+
+    /** Direct access for C++ consumers (analysis, beat scheduling). */
+    TSharedPtr<FPcmStreamSource, ESPMode::ThreadSafe> GetSource() const { return Source; }
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+    FString CachePath;
+    FString ContentHash;
+    int32 SampleRate = 0;
+    int32 NumChannels = 0;
+    bool bOpening = false;
+
+    TSharedPtr<FPcmStreamSource, ESPMode::ThreadSafe> Source;
+
+    UPROPERTY()
+    TObjectPtr<UStreamingPcmSoundWave> SoundWave;
+
+    /** Sliding window of the last analysed samples, filled from the source's analysis ring. */
+    TArray<float> AnalysisWindow;
+    TArray<float> AnalysisScratch;
+    int32 AnalysisValid = 0;
+
+    void FinishOpen(const FString& InHash, bool bSuccess);
+};
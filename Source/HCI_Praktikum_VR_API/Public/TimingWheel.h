@@ -0,0 +1,68 @@
+// TimingWheel.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Hierarchical timing wheel for many future events on one clock.
+ *
+ * Three levels of 256 slots each cover 2^24 ticks ahead; anything further
+ * waits in an overflow list. Scheduling is O(1); advancing visits one level-0
+ * slot per elapsed tick and re-files a higher-level slot into the levels below
+ * whenever the level underneath wraps. Entries live in a pooled node array with
+ * intrusive slot lists, so steady-state use does not allocate.
+ *
+ * Payloads are opaque ints (e.g. an index into the caller's event array).
+ */
+class HCI_PRAKTIKUM_VR_API_API FTimingWheel
+{
+public:
+    struct FEntry
+    {
+        double Time = 0.0;
+        int32 Payload = INDEX_NONE;
+    };
+
+    /** Empty wheel with 1 ms ticks at time 0, usable before Init. */
+    FTimingWheel() { Init(0.001, 0.0); }
+
+    /** Clear all entries; the wheel starts at Origin with the given tick length in seconds. */
+    void Init(double InTickSeconds, double Origin);
+
+    /** Times before the current tick are due on the next Advance. */
+    void Schedule(double Time, int32 Payload);
+
+    /** Append all entries with Time < UpTo to OutDue, sorted by time. */
+    void Advance(double UpTo, TArray<FEntry>& OutDue);
+
+    int32 Num() const { return Count; }
+
+private:
+    static constexpr int32 Bits = 8;
+    static constexpr int32 NumSlots = 1 << Bits;
+    static constexpr int32 Mask = NumSlots - 1;
+    static constexpr int32 NumLevels = 3;
+
+    struct FNode
+    {
+        double Time;
+        int32 Payload;
+        int32 Next;
+    };
+
+    int64 TickOf(double Time) const { return FMath::FloorToInt64((Time - Origin) / TickSeconds); }
+    void Insert(int32 NodeIndex);
+    void Cascade(int32 Level);
+    void Release(int32 NodeIndex);
+
+    double TickSeconds = 0.001;
+    double Origin = 0.0;
+    int64 CurrentTick = 0;
+    int32 Count = 0;
+
+    TArray<FNode> Nodes;
+    int32 FreeHead = INDEX_NONE;
+    int32 Heads[NumLevels][NumSlots];
+    TArray<int32> Overflow;
+};